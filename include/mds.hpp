@@ -7,20 +7,197 @@
  * @brief stores a bijective function f_I : [0..n-1] -> [0..n-1] as a balanced disjoint interval
  *        sequence B_I[0..k] (in the array D_pair), supports calculation of f_I(i) = i', with i
  *        in [0..n-1], by calculating Move(i,x) = (i',x')
- * @tparam T (integer) type of the interval starting positions
+ * @tparam T (signed or unsigned integer) type of the interval starting positions, that must be able to store n
+ * @tparam X (integer) type of the interval indices, that must be able to store k (default: T)
  */
-template <typename T>
+template <typename T, typename X = T> class mds_sched;
+template <typename T, typename X = T> class mds_exec;
+template <typename T, typename X = T> class mds_view;
+
+template <typename T, typename X>
 class mds {
-    friend class mdsb<T>;
+    friend class mdsb<T,X>;
+    friend class mds_sched<T,X>;
+    friend class mds_exec<T,X>;
+    friend class mds_view<T,X>;
 
     protected:
     T n; // maximum value, n = p_{k-1} + d_{k-1}, k <= n
-    T k; // number of intervals in the balanced disjoint inteval sequence B_I, 0 < k
+    X k; // number of intervals in the balanced disjoint inteval sequence B_I, 0 < k
     /** @brief stores the balanced disjoint inteval sequence B_I = ((p_0,q_0),(p_1,q_1),..,
      *         (p_{k-1},q_{k-1})) */
     std::vector<std::pair<T,T>> D_pair;
-    /** @brief D_index[j] = i <=> q_j in [p_i, p_i + d_i - 1], with i,j in [0..k-1] */
-    std::vector<T> D_index;
+    /** @brief D_index[j] = i <=> q_j in [p_i, p_i + d_i - 1], with i,j in [0..k-1]; if fast is set, the
+     *         highest bit of D_index[j] (fast_bit) is set, if [q_j, q_j + d_j - 1] lies in [p_i, p_i + d_i - 1] */
+    std::vector<X> D_index;
+    bool fast; // whether the fast_bit is used in D_index, which the build methods set if k < fast_bit
+    /** @brief D_lut[b] = x <=> x is the maximum integer in [0..k-1], so that p_x <= b * 2^s_lut, with
+     *         b in [0..(n-1)/2^s_lut+1] (empty, if the lookup table has not been built) */
+    std::vector<X> D_lut;
+    uint8_t s_lut; // logarithm of the distance between the positions sampled in D_lut
+
+    T t_exp; // number of linear scan steps in move, after which an exponential search is used (0: linear scan only)
+
+    /** @brief maximum size of D_lut in bytes, if its sampling distance is chosen by build_lut, so that
+     *         the table stays in the L2 cache */
+    static constexpr uint64_t lut_bytes = 1 << 18;
+
+    /** @brief number of queries the batched move query prefetches ahead per stage */
+    static constexpr uint64_t prefetch_dist = 16;
+
+    /** @brief highest bit of X, that is set in D_index[j], if move needs not scan for intervals starting at j */
+    static constexpr uint64_t fast_bit = (uint64_t) 1 << (8*sizeof(X)-1);
+
+    /** @brief number of bits of the key, that each pass of radix_sort sorts by */
+    static constexpr uint8_t radix_bits = 8;
+
+    /** @brief first 8 bytes of a serialized move datastructure, "mds" and the format version in the upper
+     *         32 bits (version 1 is the format without a header) */
+    static constexpr uint64_t format_id = (uint64_t) 2 << 32 | 0x73646d;
+
+    /** @brief size of the header of a serialized move datastructure: format_id, the flags (bit 0: fast,
+     *         bits 8-15: sizeof(T), bits 16-23: sizeof(X)), n and k, each stored in 8 bytes */
+    static constexpr uint64_t header_bytes = 32;
+
+    /**
+     * @brief returns the number of zero bytes written after D_pair in a serialized move datastructure,
+     *        so that D_index starts at a multiple of 8 bytes
+     * @param k number of intervals
+     * @return number of padding bytes
+     */
+    static inline uint64_t padding_bytes(uint64_t k) {
+        return (8-(2*(k+1)*sizeof(T))%8)%8;
+    }
+
+    /**
+     * @brief returns the flags field of the header of a serialized move datastructure
+     * @param fast whether the fast_bit is used in D_index
+     * @return flags
+     */
+    static inline uint64_t format_flags(bool fast) {
+        return (uint64_t) fast | sizeof(T) << 8 | sizeof(X) << 16;
+    }
+
+    /**
+     * @brief returns whether header is the header of a move datastructure serialized with the same
+     *        format version, T and X, whose n and k fit into T and X
+     * @param header the first header_bytes bytes of a serialized move datastructure
+     * @return whether the header is valid
+     */
+    static inline bool valid_header(const uint64_t *header) {
+        return header[0] == format_id && (header[1] & ~(uint64_t) 1) == format_flags(false) &&
+            (uint64_t) (T) header[2] == header[2] && (uint64_t) (X) header[3] == header[3];
+    }
+
+    /**
+     * @brief sorts ix and pos (if it is not NULL) stably by key with least significant digit radix sort
+     *        passes of radix_bits bits each
+     * @tparam K function (const std::pair<T,X>&, uint64_t) -> uint64_t, that returns the key of a pair
+     *           and its value in pos (0 if pos is NULL)
+     * @param ix pairs to sort
+     * @param pos (optional) values, that are permuted like ix
+     * @param key key function, the keys must be in [0..2^w-1]
+     * @param w width of the keys in bits
+     */
+    template <typename K>
+    static void radix_sort(std::vector<std::pair<T,X>> &ix, std::vector<uint64_t> *pos, K key, uint8_t w);
+
+    /**
+     * @brief returns whether the fast_bit is set in a value of D_index
+     * @param fast whether the fast_bit is used in D_index
+     * @param x_f D_index[j]
+     * @return whether [q_j, q_j + d_j - 1] lies in the input interval D_index[j]
+     */
+    static inline bool is_fast(bool fast, X x_f) {
+        return fast && ((uint64_t) x_f & fast_bit);
+    }
+
+    /**
+     * @brief removes the fast_bit from a value of D_index
+     * @param fast whether the fast_bit is used in D_index
+     * @param x_f D_index[j]
+     * @return i, so that q_j in [p_i, p_i + d_i - 1]
+     */
+    static inline X unflag(bool fast, X x_f) {
+        return fast ? (X) ((uint64_t) x_f & (fast_bit-1)) : x_f;
+    }
+
+    /**
+     * @brief the arrays and parameters read by the queries; the queries are implemented once over a
+     *        query_ctx, so that mds and mds_view, which only holds raw pointers, share them
+     */
+    struct query_ctx {
+        const std::pair<T,T> *D_pair; // D_pair[0..k]
+        const X *D_index; // D_index[0..k-1]
+        const X *D_lut; // D_lut[0..(n-1)/2^s_lut+1] (NULL, if the lookup table has not been built)
+        uint8_t s_lut; // logarithm of the distance between the positions sampled in D_lut
+        X k; // number of intervals in the balanced disjoint inteval sequence B_I
+        bool fast; // whether the fast_bit is used in D_index
+        T t_exp; // number of linear scan steps in move, after which an exponential search is used
+    };
+
+    /**
+     * @brief returns the query_ctx of this move datastructure
+     * @return query_ctx pointing to D_pair, D_index and D_lut
+     */
+    inline query_ctx ctx() const;
+
+    /**
+     * @brief returns the maximum integer x' >= x, so that p_x' <= i, by a linear scan or, if t_exp > 0,
+     *        by t_exp linear scan steps followed by an exponential search
+     * @param c query_ctx
+     * @param i in [p_x, n-1]
+     * @param x in [0..k-1]
+     * @return x'
+     */
+    static inline X scan(const query_ctx &c, T i, X x);
+
+    /**
+     * @brief implementation of locate_interval over a query_ctx
+     */
+    static X locate_interval(const query_ctx &c, T i);
+
+    /**
+     * @brief first half of move over a query_ctx, that is split, so that pipelined executors can prefetch
+     *        between the halves: calculates i' and stores D_index[x] (with its fast_bit) in ix.second
+     * @param c query_ctx
+     * @param ix pair (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
+     */
+    static inline void move_begin(const query_ctx &c, std::pair<T,X> &ix);
+
+    /**
+     * @brief second half of move over a query_ctx: turns D_index[x] (with its fast_bit) in ix.second into
+     *        x', by removing the fast_bit or by scan
+     * @param c query_ctx
+     * @param ix pair (i',D_index[x]) from move_begin
+     */
+    static inline void move_end(const query_ctx &c, std::pair<T,X> &ix);
+
+    /**
+     * @brief implementation of move over a query_ctx
+     */
+    static inline void move(const query_ctx &c, std::pair<T,X> &ix);
+
+    /**
+     * @brief implementation of move_run over a query_ctx
+     */
+    static T move_run(const query_ctx &c, std::pair<T,X> &ix);
+
+    /**
+     * @brief implementation of the batched move query over a query_ctx
+     */
+    static void move(const query_ctx &c, std::pair<T,X> *ix, uint64_t b);
+
+    /**
+     * @brief implementation of walk over a query_ctx
+     */
+    static std::pair<T,X> walk(const query_ctx &c, std::pair<T,X> ix, uint64_t steps);
+
+    /**
+     * @brief implementation of walk with an output over a query_ctx
+     */
+    template <typename O>
+    static std::pair<T,X> walk(const query_ctx &c, std::pair<T,X> ix, uint64_t steps, O out);
 
     public:
     /**
@@ -39,6 +216,8 @@ class mds {
      * @param v version of the build method (1/2/3/4) (default: 3)
      * @param log enables log messages during build process (default: false)
      * @param os output stream to write runtime and space usage to if log is enabled (default: NULL)
+     * @param l_max (optional) maximum length of the input and output intervals, input intervals longer
+     *              than l_max are split before balancing (default: 0, no maximum)
      */
     mds(
         std::vector<std::pair<T,T>> *I,
@@ -47,7 +226,8 @@ class mds {
         int p = omp_get_max_threads(),
         int v = 3,
         bool log = false,
-        std::ostream *os = NULL
+        std::ostream *os = NULL,
+        T l_max = 0
     );
 
     /**
@@ -56,48 +236,170 @@ class mds {
     ~mds();
 
     /**
-     * @brief creates a move datastructure from an input stream
+     * @brief creates a move datastructure from an input stream; the lookup table of locate_interval is
+     *        not stored in the stream and must be built again with build_lut; if the stream does not
+     *        start with a header written by serialize for the same T and X (e.g. a file written in the
+     *        format without a header), the failbit of in is set and the move datastructure stays empty
      * @param in input stream
      */
     mds(std::istream &in);
 
     /**
-     * @brief writes the move_datastructure to ab output stream
+     * @brief writes the move_datastructure to ab output stream: the header (format_id, the flags, n and k),
+     *        D_pair[0..k], padding_bytes(k) zero bytes and D_index[0..k-1]
      * @param out output stream
      * @return size of the data written to out
      */
-    uint64_t serialize(std::ostream &out);
+    uint64_t serialize(std::ostream &out) const;
+
+    /**
+     * @brief builds the move datastructure of the inverse function f_I^{-1} out of this move datastructure;
+     *        the pairs (q_i,p_i) in ascending order of q_i form a disjoint interval sequence for f_I^{-1},
+     *        which is sorted with a counting sort by D_index and then balanced by mdsb without sorting it again
+     * @param a (optional) balancing parameter, restricts size increase to the factor (1+1/(a-1))
+     *          and restricts move query runtime to 2a, 2 <= a
+     * @param p (optional) number of threads to use (default: all threads)
+     * @param v version of the build method (1/2/3/4) (default: 3)
+     * @param log enables log messages during build process (default: false)
+     * @param os output stream to write runtime and space usage to if log is enabled (default: NULL)
+     * @param l_max (optional) maximum length of the input and output intervals (default: 0, no maximum)
+     * @return move datastructure of f_I^{-1}
+     */
+    mds<T,X> inverse(
+        T a = 2,
+        int p = omp_get_max_threads(),
+        int v = 3,
+        bool log = false,
+        std::ostream *os = NULL,
+        T l_max = 0
+    ) const;
 
     /**
      * @brief returns the number of intervals in the disjoint interval sequnece (k)
      * @return number of intervals in the disjoint interval sequnece (k)
      */
-    T intervals();
+    X intervals() const;
 
     /**
      * @brief returns n
      * @return n = p_{k-1} + d_{k-1}
      */
-    T max_value();
+    T max_value() const;
 
     /**
      * @brief returns D_pair[i]
      * @param i in [0..k]
      * @return D_pair[i]
      */
-    std::pair<T,T>& pair(T i);
+    const std::pair<T,T>& pair(X i) const;
 
     /**
      * @brief returns D_index[i]
      * @param i in [0..k-1]
      * @return D_index[i]
      */
-    T index(T i);
+    X index(X i) const;
+
+    /**
+     * @brief selects the scan used by the move queries; after t linear scan steps, the scan switches to
+     *        an exponential search over the following input starting positions, which pays off for
+     *        large balancing parameters
+     * @param t number of linear scan steps (0: linear scan only, the default)
+     */
+    void set_exp_scan(T t);
+
+    /**
+     * @brief builds the lookup table for locate_interval, that samples every 2^s-th position; the table
+     *        is not serialized, so it must be built again after creating a move datastructure from an
+     *        input stream
+     * @param s (optional) logarithm of the distance between the sampled positions (default: the
+     *          smallest integer, so that the table has at most k+2 entries and occupies at most
+     *          lut_bytes bytes)
+     * @param p (optional) number of threads to use (default: all threads)
+     */
+    void build_lut(int s = -1, int p = omp_get_max_threads());
+
+    /**
+     * @brief returns the interval containing i by looking up the sampled intervals containing the
+     *        closest sampled positions before and after i and searching between them; uses a binary
+     *        search over D_pair if the lookup table has not been built
+     * @param i in [0..n-1]
+     * @return x in [0..k-1], so that i in [p_x, p_x + d_x - 1]
+     */
+    X locate_interval(T i) const;
 
     /**
      * @brief calculates the move query Move(I,i,x) = (i',x') by changing ix = (i,x)
      *        to ix' = (i',x'), with i' = f_I(i) and i' in [p_x', p_x' + d_x' - 1]
      * @param ix (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
      */
-    void move(std::pair<T,T> &ix);
+    void move(std::pair<T,X> &ix) const;
+
+    /**
+     * @brief calculates the move query Move(I,i,x) = (i',x') like move and returns the length l of the
+     *        run starting at i, that is mapped contiguously; f_I(i+t) = i'+t and i'+t in
+     *        [p_x', p_x' + d_x' - 1] for t in [0..l-1], so (i'+t,x') need not be calculated by another
+     *        move query
+     * @param ix (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
+     * @return l = min(p_{x+1} - i, p_{x'+1} - i'), 0 < l
+     */
+    T move_run(std::pair<T,X> &ix) const;
+
+    /**
+     * @brief calculates the move queries Move(I,i,x) = (i',x') for b independent pairs in lock-step,
+     *        while prefetching D_pair and D_index for the queries that are processed next
+     * @param ix array of b pairs (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1],
+     *           each pair ix[j] is changed to (i',x')
+     * @param b number of pairs in ix
+     */
+    void move(std::pair<T,X> *ix, uint64_t b) const;
+
+    /**
+     * @brief calculates the move queries Move(I,i,x) = (i',x') for a large number of independent pairs,
+     *        by first partitioning them by x into buckets of 2^s consecutive intervals with a radix sort,
+     *        so that D_pair[x] and D_index[x] are accessed bucket by bucket; each radix pass distributes
+     *        the pairs to at most 2^radix_bits buckets, so the scatter itself stays cache and TLB friendly
+     * @param ix pairs (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1], each pair
+     *           is changed to (i',x')
+     * @param ordered (optional) whether the pairs are returned in their original order, which is
+     *                restored by a radix sort by the original positions, else they are returned in
+     *                ascending order of their buckets (default: true)
+     * @param s (optional) logarithm of the number of intervals per bucket (default: the largest
+     *          integer, so that D_pair and D_index of a bucket and the pairs falling into it fit in
+     *          256KB)
+     */
+    void move_bulk(std::vector<std::pair<T,X>> &ix, bool ordered = true, int s = -1) const;
+
+    /**
+     * @brief maps the range [l,r] through f_I; because each input interval is mapped contiguously,
+     *        the image consists of at most one range per input interval intersecting [l,r]
+     * @param l in [0..n-1]
+     * @param r in [l..n-1]
+     * @param x_l x_l in [0..k-1] and l in [p_{x_l}, p_{x_l} + d_{x_l} - 1]
+     * @param out vector, to which triples (i',d,x') are appended in ascending order of the input
+     *            intervals, where [i', i' + d - 1] is the image of a maximal subrange of [l,r], whose
+     *            image is contiguous, and i' in [p_x', p_x' + d_x' - 1]; two consecutive appended
+     *            triples are never contiguous
+     */
+    void move_range(T l, T r, X x_l, std::vector<std::tuple<T,T,X>> &out) const;
+
+    /**
+     * @brief calculates steps consecutive move queries starting with ix = (i,x)
+     * @param ix (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
+     * @param steps number of move queries
+     * @return (i',x') after the last move query
+     */
+    std::pair<T,X> walk(std::pair<T,X> ix, uint64_t steps) const;
+
+    /**
+     * @brief calculates steps consecutive move queries starting with ix = (i,x) and emits each
+     *        position i' it visits (including i) to out
+     * @tparam O output iterator accepting T, or callable f(i',x')
+     * @param ix (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
+     * @param steps number of move queries
+     * @param out output iterator, to which i' is written, or function, that is called with (i',x')
+     * @return (i',x') after the last move query
+     */
+    template <typename O>
+    std::pair<T,X> walk(std::pair<T,X> ix, uint64_t steps, O out) const;
 };
\ No newline at end of file
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <mds.hpp>
+
+/**
+ * @brief move datastructure that groups the intervals into blocks of B consecutive intervals; each block
+ *        stores full-width bases for p, q and D_index and the entries of the block store their differences
+ *        to the bases in as many bits as the largest difference in the block needs; the header of a block is
+ *        stored in D_data directly before its entries and the differences of an entry are stored next to
+ *        each other; all blocks occupy the same number of words, so the b-th block is found without an
+ *        offset array, and move decodes the header and one entry of the block of x and then scans the
+ *        starting positions p_x', decoding the header of each block it enters once
+ * @tparam T (integer) type of the interval starting positions
+ * @tparam B number of intervals per block (default: 32)
+ */
+template <typename T, uint64_t B = 32>
+class mds_blocked {
+    protected:
+    /**
+     * @brief decoded header of a block, that stores the entries b*B..min((b+1)*B,k+1)-1
+     */
+    struct block_header {
+        T p; // p_{b*B}
+        T q; // minimum q_j in the block
+        T x; // minimum D_index[j] in the block
+        uint64_t o; // index of the bit in D_data, at which the entries of the block start
+        uint8_t w_p; // width of the differences p_j - p
+        uint8_t w_q; // width of the differences q_j - q
+        uint8_t w_x; // width of the differences D_index[j] - x
+        uint8_t w; // width of an entry, w = w_p + w_q + w_x
+    };
+
+    /** @brief number of words at the start of each block in D_data, that store its header: p, q, x and the
+     *         widths w_p, w_q, w_x and w in the bytes 0..3 of the fourth word */
+    static constexpr uint64_t head_words = 4;
+
+    T n; // maximum value, n = p_{k-1} + d_{k-1}, k <= n
+    T k; // number of intervals in the balanced disjoint inteval sequence B_I, 0 < k
+    uint64_t s_b; // number of words per block, so that the b-th block starts at the word b*s_b in D_data
+    /** @brief stores the blocks, each consisting of its header (head_words words) and its entries
+     *         (p_j - p, q_j - q, D_index[j] - x) in s_b words, followed by a zero word,
+     *         so that the two words containing a value can always be read; the entry k stores p_k = n */
+    std::vector<uint64_t> D_data;
+
+    /**
+     * @brief decodes the header of the b-th block
+     * @param b in [0..k/B]
+     * @return header of the b-th block
+     */
+    inline block_header head(T b) const;
+
+    /**
+     * @brief returns the w bit wide value starting at bit b in D_data
+     * @param b bit position
+     * @param w width of the value, 1 <= w <= 64
+     * @return value
+     */
+    inline uint64_t get_bits(uint64_t b, uint8_t w) const;
+
+    /**
+     * @brief writes the w bit wide value v starting at bit b into D_data, which must be zero there
+     * @param b bit position
+     * @param w width of the value, 1 <= w <= 64
+     * @param v value
+     */
+    inline void set_bits(uint64_t b, uint8_t w, uint64_t v);
+
+    public:
+    /**
+     * @brief creates an empty move datastructure
+     */
+    mds_blocked();
+
+    /**
+     * @brief creates a block-compressed move datastructure out of a move datastructure
+     * @param M move datastructure
+     */
+    mds_blocked(const mds<T> &M);
+
+    /**
+     * @brief creates a block-compressed move datastructure out of I by building a move datastructure and
+     *        compressing its D_pair and D_index
+     * @param I disjoint interval sequence I
+     * @param n n = p_{k-1} + d_{k-1}, k <= n
+     * @param a (optional) balancing parameter, restricts size increase to the factor (1+1/(a-1))
+     *          and restricts move query runtime to 2a, 2 <= a
+     * @param p (optional) number of threads to use (default: all threads)
+     * @param v version of the build method (1/2/3/4) (default: 3)
+     * @param log enables log messages during build process (default: false)
+     * @param os output stream to write runtime and space usage to if log is enabled (default: NULL)
+     */
+    mds_blocked(
+        std::vector<std::pair<T,T>> *I,
+        T n,
+        T a = 2,
+        int p = omp_get_max_threads(),
+        int v = 3,
+        bool log = false,
+        std::ostream *os = NULL
+    );
+
+    /**
+     * @brief deletes the move datastructure
+     */
+    ~mds_blocked();
+
+    /**
+     * @brief creates a block-compressed move datastructure from an input stream
+     * @param in input stream
+     */
+    mds_blocked(std::istream &in);
+
+    /**
+     * @brief writes the move datastructure to an output stream
+     * @param out output stream
+     * @return size of the data written to out
+     */
+    uint64_t serialize(std::ostream &out) const;
+
+    /**
+     * @brief returns the number of intervals in the disjoint interval sequnece (k)
+     * @return number of intervals in the disjoint interval sequnece (k)
+     */
+    T intervals() const;
+
+    /**
+     * @brief returns n
+     * @return n = p_{k-1} + d_{k-1}
+     */
+    T max_value() const;
+
+    /**
+     * @brief returns (p_x,q_x)
+     * @param x in [0..k-1]
+     * @return (p_x,q_x)
+     */
+    std::pair<T,T> pair(T x) const;
+
+    /**
+     * @brief returns D_index[x]
+     * @param x in [0..k-1]
+     * @return D_index[x]
+     */
+    T index(T x) const;
+
+    /**
+     * @brief calculates the move query Move(I,i,x) = (i',x') by changing ix = (i,x)
+     *        to ix' = (i',x'), with i' = f_I(i) and i' in [p_x', p_x' + d_x' - 1]
+     * @param ix (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
+     */
+    void move(std::pair<T,T> &ix) const;
+};
\ No newline at end of file
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <new>
+
+#include <mds.hpp>
+
+/**
+ * @brief allocator, that aligns its allocations to cache lines
+ * @tparam V value type
+ */
+template <typename V>
+struct cl_allocator {
+    using value_type = V;
+
+    cl_allocator() = default;
+    template <typename U> cl_allocator(const cl_allocator<U>&) {}
+
+    V* allocate(size_t m) {return static_cast<V*>(::operator new(m*sizeof(V),std::align_val_t(64)));}
+    void deallocate(V *v, size_t) {::operator delete(v,std::align_val_t(64));}
+
+    template <typename U> bool operator==(const cl_allocator<U>&) const {return true;}
+    template <typename U> bool operator!=(const cl_allocator<U>&) const {return false;}
+};
+
+/**
+ * @brief move datastructure, whose pairs are stored in cache line sized blocks of slots, so that the scan
+ *        of each move query stays inside the cache line it starts in. The input intervals connected to an
+ *        output interval and the slot after them are placed inside one block; blocks are padded with pairs,
+ *        that end every scan reaching them, and the first input interval connected to an output interval is
+ *        copied to the start of a new block, if it is shared with the preceding output interval and there
+ *        is no room left in its block. This holds for each scan if each output interval is connected to at
+ *        most B-1 input intervals, where B is the number of slots per block, i.e. if 2a < B; otherwise
+ *        the intervals of an output interval are spread over consecutive blocks and its scans may cross
+ *        into the next block. Since a >= 2, this requires B >= 5 slots, so T is restricted to at most
+ *        32 bits (B = 8 for 32-bit T).
+ * @tparam T (integer) type of the interval starting positions, at most 32 bits
+ */
+template <typename T>
+class mds_cl {
+    public:
+    /** @brief number of slots per block */
+    static constexpr uint64_t B = 64/sizeof(std::pair<T,T>);
+
+    protected:
+    T n; // maximum value, n = p_{k-1} + d_{k-1}, k <= n
+    T k; // number of intervals in the balanced disjoint inteval sequence B_I, 0 < k
+    T k_s; // number of slots, multiple of B
+    /** @brief D_pair[x] = (p_j,q_j), if slot x stores interval j, else x is a padding slot with
+     *         D_pair[x].first = p of the interval in the next occupied slot (or n) */
+    std::vector<std::pair<T,T>,cl_allocator<std::pair<T,T>>> D_pair;
+    /** @brief D_index[x] = slot, in which the scan of the move query for interval j starts,
+     *         if slot x stores interval j */
+    std::vector<T,cl_allocator<T>> D_index;
+
+    static_assert(sizeof(T) <= 4,"a cache line has to hold more than 2a pairs (p_j,q_j), with a >= 2");
+
+    public:
+    /**
+     * @brief creates an empty move datastructure
+     */
+    mds_cl();
+
+    /**
+     * @brief creates a move datastructure with cache line aligned blocks out of a move datastructure; the
+     *        scans stay inside their blocks, if M has been built with a balancing parameter a, 2a < B
+     * @param M move datastructure
+     */
+    mds_cl(const mds<T> &M);
+
+    /**
+     * @brief creates a move datastructure with cache line aligned blocks out of I by building a move
+     *        datastructure with the balancing parameter a and laying it out in blocks
+     * @param I disjoint interval sequence I
+     * @param n n = p_{k-1} + d_{k-1}, k <= n
+     * @param a (optional) balancing parameter, 2 <= a, the scans stay inside their blocks if 2a < B
+     *          (default: (B-1)/2)
+     * @param p (optional) number of threads to use (default: all threads)
+     * @param v version of the build method (1/2/3/4) (default: 3)
+     * @param log enables log messages during build process (default: false)
+     * @param os output stream to write runtime and space usage to if log is enabled (default: NULL)
+     */
+    mds_cl(
+        std::vector<std::pair<T,T>> *I,
+        T n,
+        T a = (B-1)/2,
+        int p = omp_get_max_threads(),
+        int v = 3,
+        bool log = false,
+        std::ostream *os = NULL
+    );
+
+    /**
+     * @brief deletes the move datastructure
+     */
+    ~mds_cl();
+
+    /**
+     * @brief creates a move datastructure with cache line aligned blocks from an input stream
+     * @param in input stream
+     */
+    mds_cl(std::istream &in);
+
+    /**
+     * @brief writes the move datastructure to an output stream
+     * @param out output stream
+     * @return size of the data written to out
+     */
+    uint64_t serialize(std::ostream &out) const;
+
+    /**
+     * @brief returns the number of intervals in the disjoint interval sequnece (k)
+     * @return number of intervals in the disjoint interval sequnece (k)
+     */
+    T intervals() const;
+
+    /**
+     * @brief returns the number of slots
+     * @return number of slots
+     */
+    T slots() const;
+
+    /**
+     * @brief returns n
+     * @return n = p_{k-1} + d_{k-1}
+     */
+    T max_value() const;
+
+    /**
+     * @brief returns the slot storing the interval containing i
+     * @param i in [0..n-1]
+     * @return slot x, so that i in [p_x, p_x + d_x - 1]
+     */
+    T locate_slot(T i) const;
+
+    /**
+     * @brief returns D_pair[x]
+     * @param x slot
+     * @return D_pair[x]
+     */
+    const std::pair<T,T>& pair(T x) const;
+
+    /**
+     * @brief calculates the move query Move(I,i,x) = (i',x') by changing ix = (i,x)
+     *        to ix' = (i',x'), with i' = f_I(i) and i' in [p_x', p_x' + d_x' - 1]
+     * @param ix (i,x), i in [0..n-1], x is a slot storing an interval containing i
+     */
+    void move(std::pair<T,T> &ix) const;
+};
\ No newline at end of file
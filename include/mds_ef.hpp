@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <packed_vector.hpp>
+#include <packed_vector.cpp>
+
+#include <ef_vector.hpp>
+#include <ef_vector.cpp>
+
+#include <mds.hpp>
+
+/**
+ * @brief move datastructure that stores the strictly increasing input interval starting positions p_i Elias-Fano
+ *        encoded in about 2 + log2(n/k) bits each, and q_i and D_index[i] bit-packed; move selects p_x and
+ *        then p_{x'+1}, from which the scan iterates over the following p_i with an ef_vector iterator, so that
+ *        it needs two selects per move query, independent of the length of the scan
+ * @tparam T (integer) type of the interval starting positions
+ */
+template <typename T>
+class mds_ef {
+    protected:
+    T n; // maximum value, n = p_{k-1} + d_{k-1}, k <= n
+    T k; // number of intervals in the balanced disjoint inteval sequence B_I, 0 < k
+    /** @brief D_p[i] = p_i, with i in [0..k-1], D_p[k] = n */
+    ef_vector<T> D_p;
+    /** @brief D_q[i] = q_i, with i in [0..k-1] */
+    packed_vector<T> D_q;
+    /** @brief D_index[j] = i <=> q_j in [p_i, p_i + d_i - 1], with i,j in [0..k-1] */
+    packed_vector<T> D_index;
+
+    public:
+    /**
+     * @brief creates an empty move datastructure
+     */
+    mds_ef();
+
+    /**
+     * @brief creates an Elias-Fano encoded move datastructure out of a move datastructure
+     * @param M move datastructure
+     */
+    mds_ef(const mds<T> &M);
+
+    /**
+     * @brief creates an Elias-Fano encoded move datastructure out of I by building a move datastructure
+     *        and encoding its D_pair and D_index
+     * @param I disjoint interval sequence I
+     * @param n n = p_{k-1} + d_{k-1}, k <= n
+     * @param a (optional) balancing parameter, restricts size increase to the factor (1+1/(a-1))
+     *          and restricts move query runtime to 2a, 2 <= a
+     * @param p (optional) number of threads to use (default: all threads)
+     * @param v version of the build method (1/2/3/4) (default: 3)
+     * @param log enables log messages during build process (default: false)
+     * @param os output stream to write runtime and space usage to if log is enabled (default: NULL)
+     */
+    mds_ef(
+        std::vector<std::pair<T,T>> *I,
+        T n,
+        T a = 2,
+        int p = omp_get_max_threads(),
+        int v = 3,
+        bool log = false,
+        std::ostream *os = NULL
+    );
+
+    /**
+     * @brief deletes the move datastructure
+     */
+    ~mds_ef();
+
+    /**
+     * @brief creates an Elias-Fano encoded move datastructure from an input stream
+     * @param in input stream
+     */
+    mds_ef(std::istream &in);
+
+    /**
+     * @brief writes the move datastructure to an output stream
+     * @param out output stream
+     * @return size of the data written to out
+     */
+    uint64_t serialize(std::ostream &out) const;
+
+    /**
+     * @brief returns the number of intervals in the disjoint interval sequnece (k)
+     * @return number of intervals in the disjoint interval sequnece (k)
+     */
+    T intervals() const;
+
+    /**
+     * @brief returns n
+     * @return n = p_{k-1} + d_{k-1}
+     */
+    T max_value() const;
+
+    /**
+     * @brief returns (p_x,q_x)
+     * @param x in [0..k-1]
+     * @return (p_x,q_x)
+     */
+    std::pair<T,T> pair(T x) const;
+
+    /**
+     * @brief returns D_index[x]
+     * @param x in [0..k-1]
+     * @return D_index[x]
+     */
+    T index(T x) const;
+
+    /**
+     * @brief calculates the move query Move(I,i,x) = (i',x') by changing ix = (i,x)
+     *        to ix' = (i',x'), with i' = f_I(i) and i' in [p_x', p_x' + d_x' - 1]
+     * @param ix (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
+     */
+    void move(std::pair<T,T> &ix) const;
+};
\ No newline at end of file
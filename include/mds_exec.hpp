@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+
+#include <mds.hpp>
+
+/**
+ * @brief executes batches of independent move queries on a move datastructure in parallel; each thread
+ *        processes chunks of the queries in b lanes, that advance round-robin one stage at a time and
+ *        prefetch the memory accessed by their next stage
+ * @tparam T (integer) type of the interval starting positions
+ * @tparam X (integer) type of the interval indices
+ */
+template <typename T, typename X>
+class mds_exec {
+    protected:
+    const mds<T,X> *M; // move datastructure to perform the move queries on
+    int p; // number of threads to use
+    uint64_t b; // number of lanes per thread
+    uint64_t c; // number of queries per chunk
+    uint64_t m; // number of move queries calculated in the last run
+    std::chrono::steady_clock::duration t; // runtime of the last run
+
+    /**
+     * @brief calculates steps[j] consecutive move queries on ix[j] for each j in [l..r-1]
+     * @param ix pairs (i,x)
+     * @param steps number of move queries per pair (NULL, if it is s_all for all pairs)
+     * @param s_all number of move queries per pair, if steps is NULL
+     * @param l first query
+     * @param r query after the last one
+     */
+    void run_chunk(std::pair<T,X> *ix, uint64_t *steps, uint64_t s_all, uint64_t l, uint64_t r);
+
+    /**
+     * @brief calculates the move queries on all pairs with the number of move queries per pair given by
+     *        steps or s_all
+     * @param ix pairs (i,x)
+     * @param steps number of move queries per pair (NULL, if it is s_all for all pairs)
+     * @param s_all number of move queries per pair, if steps is NULL
+     * @param q number of pairs
+     */
+    void run(std::pair<T,X> *ix, uint64_t *steps, uint64_t s_all, uint64_t q);
+
+    public:
+    /**
+     * @brief creates an executor
+     * @param M move datastructure to perform the move queries on
+     * @param p (optional) number of threads to use (default: all threads)
+     * @param b (optional) number of lanes per thread (default: 32)
+     * @param c (optional) number of queries per chunk (default: 4096)
+     */
+    mds_exec(const mds<T,X> *M, int p = omp_get_max_threads(), uint64_t b = 32, uint64_t c = 4096);
+
+    /**
+     * @brief deletes the executor
+     */
+    ~mds_exec();
+
+    /**
+     * @brief calculates steps[j] consecutive move queries on ix[j] for each j in [0..|ix|-1]
+     * @param ix pairs (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
+     * @param steps number of move queries per pair, |steps| = |ix|
+     */
+    void run(std::vector<std::pair<T,X>> &ix, std::vector<uint64_t> &steps);
+
+    /**
+     * @brief calculates steps consecutive move queries on each pair in ix
+     * @param ix pairs (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
+     * @param steps number of move queries per pair
+     */
+    void run(std::vector<std::pair<T,X>> &ix, uint64_t steps);
+
+    /**
+     * @brief returns the number of move queries calculated in the last run
+     * @return number of move queries calculated in the last run
+     */
+    uint64_t moves();
+
+    /**
+     * @brief returns the runtime of the last run in ms
+     * @return runtime of the last run in ms
+     */
+    double runtime();
+
+    /**
+     * @brief returns the throughput of the last run
+     * @return number of move queries per second calculated in the last run
+     */
+    double throughput();
+};
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <mds.hpp>
+
+/**
+ * @brief move datastructure with the balancing parameter a = A fixed at compile time; because an output
+ *        interval is connected to at most 2A input intervals, the scan in move is replaced by a fixed
+ *        number of 2A-1 branchless comparisons
+ * @tparam T (integer) type of the interval starting positions
+ * @tparam A balancing parameter, 2 <= A
+ */
+template <typename T, uint64_t A>
+class mds_fixed : public mds<T> {
+    static_assert(2 <= A);
+
+    protected:
+    /**
+     * @brief appends 2A-2 pairs (n,n) to D_pair, so that D_pair[x+1..x+2A-1] can be read for each x in [0..k-1]
+     */
+    void pad_dpair();
+
+    public:
+    /**
+     * @brief creates an empty move datastructure
+     */
+    mds_fixed();
+
+    /**
+     * @brief creates a move datastructure out of I with the balancing parameter A
+     * @param I disjoint interval sequence I
+     * @param n n = p_{k-1} + d_{k-1}, k <= n
+     * @param p (optional) number of threads to use (default: all threads)
+     * @param v version of the build method (1/2/3/4) (default: 3)
+     * @param log enables log messages during build process (default: false)
+     * @param os output stream to write runtime and space usage to if log is enabled (default: NULL)
+     */
+    mds_fixed(
+        std::vector<std::pair<T,T>> *I,
+        T n,
+        int p = omp_get_max_threads(),
+        int v = 3,
+        bool log = false,
+        std::ostream *os = NULL
+    );
+
+    /**
+     * @brief creates a move datastructure from an input stream, the move datastructure must have been
+     *        built with a balancing parameter a <= A
+     * @param in input stream
+     */
+    mds_fixed(std::istream &in);
+
+    using mds<T>::move;
+
+    /**
+     * @brief calculates the move query Move(I,i,x) = (i',x') by changing ix = (i,x)
+     *        to ix' = (i',x'), with i' = f_I(i) and i' in [p_x', p_x' + d_x' - 1]
+     * @param ix (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
+     */
+    void move(std::pair<T,T> &ix) const;
+};
\ No newline at end of file
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <bit>
+
+#include <mds.hpp>
+
+/**
+ * @brief move datastructure that stores p_i, q_i and D_index[i] of each interval in one record,
+ *        so a move query accesses one record for the lookup and the following records for the scan
+ * @tparam T (integer) type of the interval starting positions
+ */
+template <typename T>
+class mds_fused {
+    public:
+    /**
+     * @brief stores the pair (p_i,q_i) and D_index[i] of an interval; the record is padded and aligned to
+     *        4*sizeof(T) bytes (rounded up to a power of two), so that no record straddles two cache lines,
+     *        which costs a quarter more space than 3*sizeof(T) bytes per record
+     */
+    struct alignas(std::bit_ceil(4*sizeof(T))) interv_rec {
+        T p; // starting position p_i of the input interval
+        T q; // starting position q_i of the output interval
+        T idx; // D_index[i]
+        T pad = 0; // padding, so that the serialized records do not contain uninitialized bytes
+    };
+
+    protected:
+    T n; // maximum value, n = p_{k-1} + d_{k-1}, k <= n
+    T k; // number of intervals in the balanced disjoint inteval sequence B_I, 0 < k
+    /** @brief D_rec[i] = (p_i,q_i,D_index[i]), with i in [0..k-1], D_rec[k] = (n,n,0) */
+    std::vector<interv_rec> D_rec;
+
+    public:
+    /**
+     * @brief creates an empty move datastructure
+     */
+    mds_fused();
+
+    /**
+     * @brief creates a move datastructure with fused interval records out of a move datastructure
+     * @param M move datastructure
+     */
+    mds_fused(const mds<T> &M);
+
+    /**
+     * @brief creates a move datastructure with fused interval records out of I by building a move
+     *        datastructure and fusing its D_pair and D_index
+     * @param I disjoint interval sequence I
+     * @param n n = p_{k-1} + d_{k-1}, k <= n
+     * @param a (optional) balancing parameter, restricts size increase to the factor (1+1/(a-1))
+     *          and restricts move query runtime to 2a, 2 <= a
+     * @param p (optional) number of threads to use (default: all threads)
+     * @param v version of the build method (1/2/3/4) (default: 3)
+     * @param log enables log messages during build process (default: false)
+     * @param os output stream to write runtime and space usage to if log is enabled (default: NULL)
+     */
+    mds_fused(
+        std::vector<std::pair<T,T>> *I,
+        T n,
+        T a = 2,
+        int p = omp_get_max_threads(),
+        int v = 3,
+        bool log = false,
+        std::ostream *os = NULL
+    );
+
+    /**
+     * @brief deletes the move datastructure
+     */
+    ~mds_fused();
+
+    /**
+     * @brief creates a move datastructure with fused interval records from an input stream
+     * @param in input stream
+     */
+    mds_fused(std::istream &in);
+
+    /**
+     * @brief writes the move datastructure to an output stream
+     * @param out output stream
+     * @return size of the data written to out
+     */
+    uint64_t serialize(std::ostream &out) const;
+
+    /**
+     * @brief returns the number of intervals in the disjoint interval sequnece (k)
+     * @return number of intervals in the disjoint interval sequnece (k)
+     */
+    T intervals() const;
+
+    /**
+     * @brief returns n
+     * @return n = p_{k-1} + d_{k-1}
+     */
+    T max_value() const;
+
+    /**
+     * @brief returns D_rec[i]
+     * @param i in [0..k]
+     * @return D_rec[i]
+     */
+    const interv_rec& record(T i) const;
+
+    /**
+     * @brief calculates the move query Move(I,i,x) = (i',x') by changing ix = (i,x)
+     *        to ix' = (i',x'), with i' = f_I(i) and i' in [p_x', p_x' + d_x' - 1]
+     * @param ix (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
+     */
+    void move(std::pair<T,T> &ix) const;
+};
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+
+#include <mds_view.hpp>
+
+/**
+ * @brief view of a serialized move datastructure, that maps the file written by mds<T,X>::serialize into
+ *        memory and queries it in place instead of reading it into vectors; the pages are loaded on first
+ *        access (or all at once if populate is set) and are shared through the page cache by all processes
+ *        mapping the same file
+ * @tparam T (integer) type of the interval starting positions
+ * @tparam X (integer) type of the interval indices (default: T)
+ */
+template <typename T, typename X = T>
+class mds_mmap : public mds_view<T,X> {
+    protected:
+    void *addr; // start of the mapping (NULL, if no file is mapped)
+    uint64_t len; // length of the mapping in bytes
+
+    /**
+     * @brief unmaps the file and empties the view
+     */
+    void unmap();
+
+    public:
+    /**
+     * @brief creates an empty view, that has no file mapped
+     */
+    mds_mmap();
+
+    /**
+     * @brief maps the serialized move datastructure in the file path into memory; if the file cannot be
+     *        opened, mapped or is too small, the view stays empty and good() returns false
+     * @param path file written by mds<T,X>::serialize
+     * @param populate (optional) prefaults all pages with MAP_POPULATE and MADV_WILLNEED, so that no query
+     *                 waits for a page fault; otherwise MADV_RANDOM disables readahead (default: false)
+     * @param hugepages (optional) asks the kernel with MADV_HUGEPAGE to back the mapping with huge pages,
+     *                  which takes effect where the file system supports them (default: false)
+     */
+    mds_mmap(const std::string &path, bool populate = false, bool hugepages = false);
+
+    mds_mmap(const mds_mmap&) = delete;
+    mds_mmap& operator=(const mds_mmap&) = delete;
+
+    /**
+     * @brief moves the mapping of other into the new view and leaves other empty
+     * @param other view to move from
+     */
+    mds_mmap(mds_mmap &&other);
+
+    /**
+     * @brief unmaps the current file, moves the mapping of other into this view and leaves other empty
+     * @param other view to move from
+     * @return this view
+     */
+    mds_mmap& operator=(mds_mmap &&other);
+
+    /**
+     * @brief unmaps the file
+     */
+    ~mds_mmap();
+
+    /**
+     * @brief returns whether a file is mapped
+     * @return whether a file is mapped
+     */
+    bool good() const;
+};
\ No newline at end of file
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <coroutine>
+
+#include <mds.hpp>
+
+/**
+ * @brief schedules walkers (coroutines that perform consecutive move queries on a move datastructure)
+ *        round-robin; each walker suspends after it has prefetched the memory its next access
+ *        depends on, so the memory accesses of the other walkers overlap with its cache misses
+ * @tparam T (integer) type of the interval starting positions
+ * @tparam X (integer) type of the interval indices
+ */
+template <typename T, typename X>
+class mds_sched {
+    public:
+    /**
+     * @brief coroutine that is resumed by the scheduler until it has finished
+     */
+    class walker {
+        public:
+        struct promise_type {
+            walker get_return_object() {return walker(std::coroutine_handle<promise_type>::from_promise(*this));}
+            std::suspend_always initial_suspend() noexcept {return {};}
+            std::suspend_always final_suspend() noexcept {return {};}
+            void return_void() {}
+            void unhandled_exception() {std::terminate();}
+        };
+
+        protected:
+        std::coroutine_handle<promise_type> h; // handle of the coroutine
+
+        public:
+        /**
+         * @brief creates a walker from the handle of its coroutine
+         * @param h handle of the coroutine
+         */
+        walker(std::coroutine_handle<promise_type> h);
+
+        /**
+         * @brief moves a walker
+         * @param w walker
+         */
+        walker(walker &&w);
+
+        /**
+         * @brief destroys the coroutine of the walker
+         */
+        ~walker();
+
+        /**
+         * @brief moves a walker
+         * @param w walker
+         * @return this walker
+         */
+        walker& operator=(walker &&w);
+
+        /**
+         * @brief resumes the walker until it suspends again
+         * @return whether the walker has not finished yet
+         */
+        bool resume();
+    };
+
+    /**
+     * @brief awaitable, that prefetches up to two addresses and suspends the walker awaiting it
+     */
+    struct prefetch {
+        const void *a1; // first address to prefetch
+        const void *a2; // second address to prefetch (NULL, if there is none)
+
+        bool await_ready() noexcept {return false;}
+        void await_suspend(std::coroutine_handle<>) noexcept {
+            __builtin_prefetch(a1);
+            if (a2 != NULL) __builtin_prefetch(a2);
+        }
+        void await_resume() noexcept {}
+    };
+
+    protected:
+    const mds<T,X> *M; // move datastructure to perform the move queries on
+    std::vector<walker> W; // walkers that have not finished yet
+
+    public:
+    /**
+     * @brief creates a scheduler without walkers
+     * @param M move datastructure to perform the move queries on
+     */
+    mds_sched(const mds<T,X> *M);
+
+    /**
+     * @brief deletes the scheduler and all walkers, that have not finished yet
+     */
+    ~mds_sched();
+
+    /**
+     * @brief adds a walker to the scheduler
+     * @param w walker
+     */
+    void add(walker &&w);
+
+    /**
+     * @brief resumes the walkers round-robin until all of them have finished
+     */
+    void run();
+
+    /**
+     * @brief walker that calculates steps consecutive move queries on ix, it suspends before the lookup
+     *        of D_pair[x] and D_index[x] and, if the fast_bit is not set, before the scan starting at
+     *        D_pair[x'+1]
+     * @param ix (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1], must be valid until
+     *           the walker has finished
+     * @param steps number of move queries
+     * @return walker
+     */
+    walker walk(std::pair<T,X> &ix, uint64_t steps);
+
+    /**
+     * @brief calculates steps consecutive move queries on each pair in ix by running at most w walkers
+     *        at a time
+     * @param ix pairs (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
+     * @param steps number of move queries per pair
+     * @param w (optional) number of walkers to run at a time (default: 32)
+     */
+    void walk(std::vector<std::pair<T,X>> &ix, uint64_t steps, uint64_t w = 32);
+
+    protected:
+    /**
+     * @brief walker that calculates steps consecutive move queries on ix[0], ix[w], ix[2w], ... by
+     *        move_begin and move_end of mds over the query_ctx of M, so that it uses the fast_bit and t_exp
+     * @param ix pairs (i,x)
+     * @param m number of pairs
+     * @param w distance between the pairs
+     * @param steps number of move queries per pair
+     * @return walker
+     */
+    walker walk_strided(std::pair<T,X> *ix, uint64_t m, uint64_t w, uint64_t steps);
+};
\ No newline at end of file
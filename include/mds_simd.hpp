@@ -0,0 +1,113 @@
+#pragma once
+
+#include <immintrin.h>
+
+#include <mds.hpp>
+
+/**
+ * @brief move datastructure that stores the starting positions p_i of the input intervals contiguously
+ *        and scans them in windows of simd_width values with AVX-512/AVX2 compare instructions
+ * @tparam T (integer) type of the interval starting positions
+ */
+template <typename T>
+class mds_simd {
+    public:
+    /** @brief number of starting positions compared at once by the scan in move */
+    static constexpr uint64_t simd_width =
+    #if defined(__AVX512F__)
+        (sizeof(T) == 8 || sizeof(T) == 4) ? 64/sizeof(T) : 1;
+    #elif defined(__AVX2__)
+        (sizeof(T) == 8 || sizeof(T) == 4) ? 32/sizeof(T) : 1;
+    #else
+        1;
+    #endif
+
+    protected:
+    T n; // maximum value, n = p_{k-1} + d_{k-1}, k <= n
+    T k; // number of intervals in the balanced disjoint inteval sequence B_I, 0 < k
+    /** @brief D_p[i] = p_i, with i in [0..k-1], D_p[k..k+simd_width] = n */
+    std::vector<T> D_p;
+    /** @brief D_q[i] = q_i, with i in [0..k-1] */
+    std::vector<T> D_q;
+    /** @brief D_index[j] = i <=> q_j in [p_i, p_i + d_i - 1], with i,j in [0..k-1] */
+    std::vector<T> D_index;
+
+    /**
+     * @brief returns the maximum integer x' >= x, so that p_x' <= i
+     * @param i in [p_x, n-1]
+     * @param x in [0..k-1]
+     * @return x'
+     */
+    inline T scan(T i, T x) const;
+
+    public:
+    /**
+     * @brief creates an empty move datastructure
+     */
+    mds_simd();
+
+    /**
+     * @brief creates a move datastructure with contiguous starting positions out of a move datastructure
+     * @param M move datastructure
+     */
+    mds_simd(const mds<T> &M);
+
+    /**
+     * @brief creates a move datastructure with contiguous starting positions out of I by building a move
+     *        datastructure and splitting its D_pair
+     * @param I disjoint interval sequence I
+     * @param n n = p_{k-1} + d_{k-1}, k <= n
+     * @param a (optional) balancing parameter, restricts size increase to the factor (1+1/(a-1))
+     *          and restricts move query runtime to 2a, 2 <= a
+     * @param p (optional) number of threads to use (default: all threads)
+     * @param v version of the build method (1/2/3/4) (default: 3)
+     * @param log enables log messages during build process (default: false)
+     * @param os output stream to write runtime and space usage to if log is enabled (default: NULL)
+     */
+    mds_simd(
+        std::vector<std::pair<T,T>> *I,
+        T n,
+        T a = 2,
+        int p = omp_get_max_threads(),
+        int v = 3,
+        bool log = false,
+        std::ostream *os = NULL
+    );
+
+    /**
+     * @brief deletes the move datastructure
+     */
+    ~mds_simd();
+
+    /**
+     * @brief creates a move datastructure with contiguous starting positions from an input stream
+     * @param in input stream
+     */
+    mds_simd(std::istream &in);
+
+    /**
+     * @brief writes the move datastructure to an output stream
+     * @param out output stream
+     * @return size of the data written to out
+     */
+    uint64_t serialize(std::ostream &out) const;
+
+    /**
+     * @brief returns the number of intervals in the disjoint interval sequnece (k)
+     * @return number of intervals in the disjoint interval sequnece (k)
+     */
+    T intervals() const;
+
+    /**
+     * @brief returns n
+     * @return n = p_{k-1} + d_{k-1}
+     */
+    T max_value() const;
+
+    /**
+     * @brief calculates the move query Move(I,i,x) = (i',x') by changing ix = (i,x)
+     *        to ix' = (i',x'), with i' = f_I(i) and i' in [p_x', p_x' + d_x' - 1]
+     * @param ix (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
+     */
+    void move(std::pair<T,T> &ix) const;
+};
\ No newline at end of file
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <mds.hpp>
+
+/**
+ * @brief immutable view of a move datastructure, that reads D_pair and D_index from memory it does not
+ *        own (the vectors of a move datastructure, a serialized move datastructure in a buffer, an
+ *        mmap'ed file or shared memory); all queries are const and do not write to the view, so one
+ *        view, or one copy of the referenced memory, can serve any number of threads and processes; the
+ *        queries are the ones of mds<T,X>, which are run on the referenced memory
+ * @tparam T (integer) type of the interval starting positions
+ * @tparam X (integer) type of the interval indices (default: T)
+ */
+template <typename T, typename X>
+class mds_view {
+    protected:
+    T n; // maximum value, n = p_{k-1} + d_{k-1}, k <= n
+    /** @brief D_pair[0..k], D_index[0..k-1] (with the fast_bit of mds<T,X> set, if c.fast is set), the lookup
+     *         table (if viewing a move datastructure, that has built it) and k */
+    typename mds<T,X>::query_ctx c;
+
+    public:
+    /**
+     * @brief creates an empty view
+     */
+    mds_view();
+
+    /**
+     * @brief creates a view of a move datastructure, M must not be changed or destroyed while the
+     *        view is used
+     * @param M move datastructure
+     */
+    mds_view(const mds<T,X> &M);
+
+    /**
+     * @brief creates a view of a move datastructure, that has been written to memory by
+     *        mds<T,X>::serialize (see valid_header); the memory must stay valid while the view is used
+     * @param buf start of the serialized move datastructure, aligned to 8 bytes
+     */
+    mds_view(const void *buf);
+
+    /**
+     * @brief creates a view of the arrays D_pair[0..k] and D_index[0..k-1]
+     * @param n n = p_{k-1} + d_{k-1}, k <= n
+     * @param k number of intervals, 0 < k
+     * @param D_pair array of the k+1 pairs (p_0,q_0),..,(p_{k-1},q_{k-1}),(n,n)
+     * @param D_index array of the k values D_index[0..k-1]
+     * @param fast whether the fast_bit of mds<T,X> is used in D_index
+     */
+    mds_view(T n, X k, const std::pair<T,T> *D_pair, const X *D_index, bool fast);
+
+    /**
+     * @brief returns whether buf starts with the header, that mds<T,X>::serialize writes, i.e. whether the
+     *        format version and the sizes of T and X match and n and k fit into T and X
+     * @param buf memory of at least mds<T,X>::header_bytes bytes, aligned to 8 bytes
+     * @return whether buf starts with a valid header
+     */
+    static bool valid_header(const void *buf);
+
+    /**
+     * @brief returns the size of the move datastructure in its serialized form
+     * @param k number of intervals
+     * @return size of the data mds<T,X>::serialize writes for a move datastructure with k intervals
+     */
+    static uint64_t size_in_bytes(X k);
+
+    /**
+     * @brief returns the size of the move datastructure in its serialized form
+     * @return size of the data mds<T,X>::serialize writes for the viewed move datastructure
+     */
+    uint64_t size_in_bytes() const;
+
+    /**
+     * @brief returns the number of intervals in the disjoint interval sequnece (k)
+     * @return number of intervals in the disjoint interval sequnece (k)
+     */
+    X intervals() const;
+
+    /**
+     * @brief returns n
+     * @return n = p_{k-1} + d_{k-1}
+     */
+    T max_value() const;
+
+    /**
+     * @brief returns D_pair[i]
+     * @param i in [0..k]
+     * @return D_pair[i]
+     */
+    const std::pair<T,T>& pair(X i) const;
+
+    /**
+     * @brief returns D_index[i]
+     * @param i in [0..k-1]
+     * @return D_index[i]
+     */
+    X index(X i) const;
+
+    /**
+     * @brief selects the scan used by the move queries like mds<T,X>::set_exp_scan
+     * @param t number of linear scan steps (0: linear scan only)
+     */
+    void set_exp_scan(T t);
+
+    /**
+     * @brief returns the interval containing i by the lookup table of the viewed move datastructure, or by
+     *        a binary search over D_pair, if it has not been built or the view references serialized memory
+     * @param i in [0..n-1]
+     * @return x in [0..k-1], so that i in [p_x, p_x + d_x - 1]
+     */
+    X locate_interval(T i) const;
+
+    /**
+     * @brief calculates the move query Move(I,i,x) = (i',x') by changing ix = (i,x)
+     *        to ix' = (i',x'), with i' = f_I(i) and i' in [p_x', p_x' + d_x' - 1]
+     * @param ix (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
+     */
+    void move(std::pair<T,X> &ix) const;
+
+    /**
+     * @brief calculates the move query Move(I,i,x) = (i',x') like move and returns the length l of the
+     *        run starting at i, that is mapped contiguously; f_I(i+t) = i'+t and i'+t in
+     *        [p_x', p_x' + d_x' - 1] for t in [0..l-1], so (i'+t,x') need not be calculated by another
+     *        move query
+     * @param ix (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
+     * @return l = min(p_{x+1} - i, p_{x'+1} - i'), 0 < l
+     */
+    T move_run(std::pair<T,X> &ix) const;
+
+    /**
+     * @brief calculates the move queries Move(I,i,x) = (i',x') for b independent pairs in lock-step,
+     *        while prefetching D_pair and D_index for the queries that are processed next
+     * @param ix array of b pairs (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1],
+     *           each pair ix[j] is changed to (i',x')
+     * @param b number of pairs in ix
+     */
+    void move(std::pair<T,X> *ix, uint64_t b) const;
+
+    /**
+     * @brief calculates steps consecutive move queries starting with ix = (i,x)
+     * @param ix (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
+     * @param steps number of move queries
+     * @return (i',x') after the last move query
+     */
+    std::pair<T,X> walk(std::pair<T,X> ix, uint64_t steps) const;
+
+    /**
+     * @brief calculates steps consecutive move queries starting with ix = (i,x) and emits each
+     *        position i' it visits (including i) to out
+     * @tparam O output iterator accepting T, or callable f(i',x')
+     * @param ix (i,x), i in [0..n-1], x in [0..k-1] and i in [p_x, p_x + d_x - 1]
+     * @param steps number of move queries
+     * @param out output iterator, to which i' is written, or function, that is called with (i',x')
+     * @return (i',x') after the last move query
+     */
+    template <typename O>
+    std::pair<T,X> walk(std::pair<T,X> ix, uint64_t steps, O out) const;
+};
\ No newline at end of file
@@ -13,7 +13,9 @@
 #include <dg_io_nc.hpp>
 #include <dg_io_nc.cpp>
 
-template <typename T> class mds;
+#include <uint40.hpp>
+
+template <typename T, typename X = T> class mds;
 
 template <typename T> using interv_pair = std::pair<T,T>;
 template <typename T> using interv_seq = std::vector<interv_pair<T>>;
@@ -47,8 +49,9 @@ template <typename T> using ins_matr_v4 = std::vector<std::vector<moodycamel::Co
 /**
  * @brief builds a mds
  * @tparam T (integer) type of the interval starting positions
+ * @tparam X (integer) type of the interval indices (default: T)
  */
-template <typename T>
+template <typename T, typename X = T>
 class mdsb {
     public:
     /**
@@ -62,8 +65,13 @@ class mdsb {
      * @param v version of the build method (1/2/3/4)
      * @param log enables log messages during build process
      * @param os output stream to write runtime and space usage to if log is enabled (default: NULL)
+     * @param pi_I (optional) permutation of [0..k-1], that sorts I by q_i; if it is given, it is used by the
+     *             build methods 2/3/4 instead of sorting I again and its contents are moved (default: NULL)
+     * @param l_max (optional) maximum interval length L; before balancing, each input interval longer than L
+     *              is split into intervals of length at most L, so that all input and output intervals of the
+     *              balanced sequence have length at most L (default: 0, no maximum)
      */
-    mdsb(mds<T> *mds, interv_seq<T> *I, T n, T a, int p, int v, bool log, std::ostream *os = NULL);
+    mdsb(mds<T,X> *mds, interv_seq<T> *I, T n, T a, int p, int v, bool log, std::ostream *os = NULL, std::vector<X> *pi_I = NULL, T l_max = 0);
 
     /**
      * @brief deletes the mdsb
@@ -78,12 +86,22 @@ class mdsb {
     // ############################# VARIABLES #############################
 
     protected:
-    mds<T> *md; // pointer to the move datastructure to build
+    mds<T,X> *md; // pointer to the move datastructure to build
     T n; // maximum value, n = p_{k-1} + d_{k-1}, k <= n
-    T k; // number of intervals in the balanced inteval sequence B_I, 0 < k
+    X k; // number of intervals in the balanced inteval sequence B_I, 0 < k
     T a; // balancing parameter, restricts size increase to the factor (1+1/(a-1)), 2 <= a
     int p; // number of threads to use
 
+    /**
+     * @brief splits each input interval [p_i, p_i + d_i - 1] in I with d_i > l_max into the intervals
+     *        [p_i + t*l_max, min(p_i + (t+1)*l_max, p_i + d_i) - 1], t in [0..(d_i-1)/l_max], and
+     *        updates k and pi_I (if it is given) accordingly
+     * @param I disjoint interval sequence
+     * @param l_max maximum interval length, 0 < l_max
+     * @param pi_I (optional) permutation of [0..k-1], that sorts I by q_i (default: NULL)
+     */
+    void split_intervals(interv_seq<T> *I, T l_max, std::vector<X> *pi_I = NULL);
+
     // ############################# V1 #############################
 
     /**
@@ -128,16 +146,19 @@ class mdsb {
      * @param v version of the build method
      * @param log enables log messages
      * @param os output stream to write runtime and space usage to if log is enabled (default: NULL)
+     * @param pi_I (optional) permutation of [0..k-1], that sorts I by q_i (default: NULL)
      */
-    void build_v2_v3_v4(interv_seq<T> *I, int v, bool log, std::ostream *os = NULL);
+    void build_v2_v3_v4(interv_seq<T> *I, int v, bool log, std::ostream *os = NULL, std::vector<X> *pi_I = NULL);
 
     // ############################# V2/V3/V4 SEQUENTIAL/PARALLEL #############################
 
     /**
      * @brief builds L_in[0..p-1] and T_out[0..p-1] out of the disjoint interval sequence I
      * @param I disjoint interval sequence
+     * @param pi_I (optional) permutation of [0..k-1], that sorts I by q_i; if it is NULL, it is calculated
+     *             by sorting (default: NULL)
      */
-    void build_lin_tout(interv_seq<T> *I);
+    void build_lin_tout(interv_seq<T> *I, std::vector<X> *pi_I = NULL);
 
     /**
      * @brief inserts the pairs in L_in[0..p-1] into D_pair
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <functional>
+
+#include <packed_vector.hpp>
+#include <packed_vector.cpp>
+
+/**
+ * @brief Elias-Fano encoding of a non-decreasing sequence of m integers in [0..u]; the l = floor(log2(u/m))
+ *        low bits of each value are stored in a packed vector, the high bits in unary in a bitvector of
+ *        m + u/2^l + 1 bits, which takes about 2 + log2(u/m) bits per value
+ * @tparam T (integer) value type
+ */
+template <typename T>
+class ef_vector {
+    protected:
+    uint64_t m; // number of values
+    T u; // maximum value
+    uint8_t l; // number of low bits per value
+    /** @brief L[i] stores the l low bits of the i-th value */
+    packed_vector<T> L;
+    /** @brief H[(v_i >> l) + i] = 1 for each i in [0..m-1], followed by a zero word */
+    std::vector<uint64_t> H;
+    /** @brief S[j] stores the position of the (j * 2^s_sel)-th one in H */
+    std::vector<uint64_t> S;
+
+    /** @brief logarithm of the number of ones in H between two samples in S */
+    static constexpr uint8_t s_sel = 8;
+
+    /**
+     * @brief returns the position of the i-th one in H
+     * @param i in [0..m-1]
+     * @return position of the i-th one in H
+     */
+    inline uint64_t select(uint64_t i) const;
+
+    public:
+    /**
+     * @brief iterates forward over the values of an ef_vector by searching the next one in H, which is
+     *        cheaper than a select for each value
+     */
+    class ef_it {
+        protected:
+        const ef_vector<T> *v; // the ef_vector, the iterator iterates through
+        uint64_t i; // index of the value the iterator points to
+        uint64_t pos; // position of the i-th one in H
+
+        public:
+        /**
+         * @brief creates an ef_it pointing to the i-th value of v
+         * @param v an ef_vector
+         * @param i in [0..m-1]
+         */
+        ef_it(const ef_vector<T> *v, uint64_t i);
+
+        /**
+         * @brief returns the value the iterator points to
+         * @return the value the iterator points to
+         */
+        inline T current() const;
+
+        /**
+         * @brief iterates forward, the iterator must not point to the last value
+         * @return the value the iterator points to after iterating forward
+         */
+        inline T next();
+    };
+
+    /**
+     * @brief creates an empty ef_vector
+     */
+    ef_vector();
+
+    /**
+     * @brief creates an ef_vector out of m non-decreasing values in [0..u]
+     * @param m number of values
+     * @param u maximum value
+     * @param at function returning the i-th value, with i in [0..m-1]
+     */
+    ef_vector(uint64_t m, T u, std::function<T(uint64_t)> at);
+
+    /**
+     * @brief deletes the ef_vector
+     */
+    ~ef_vector();
+
+    /**
+     * @brief creates an ef_vector from an input stream
+     * @param in input stream
+     */
+    ef_vector(std::istream &in);
+
+    /**
+     * @brief writes the ef_vector to an output stream
+     * @param out output stream
+     * @return size of the data written to out
+     */
+    uint64_t serialize(std::ostream &out) const;
+
+    /**
+     * @brief returns the number of values
+     * @return number of values
+     */
+    uint64_t size() const;
+
+    /**
+     * @brief returns the i-th value
+     * @param i in [0..m-1]
+     * @return i-th value
+     */
+    inline T operator[](uint64_t i) const;
+
+    /**
+     * @brief returns an iterator pointing to the i-th value
+     * @param i in [0..m-1]
+     * @return an iterator
+     */
+    ef_vector<T>::ef_it iterator(uint64_t i) const;
+};
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief vector of fixed-width integers, that are packed into 64-bit words
+ * @tparam T (integer) value type
+ */
+template <typename T>
+class packed_vector {
+    protected:
+    uint64_t m; // number of values
+    uint8_t w; // width of each value in bits, 0 <= w <= 64
+    uint64_t mask; // the w lowest bits set
+    /** @brief stores the values in w bit wide fields, followed by a zero word, so that the two words
+     *         containing a value can always be read */
+    std::vector<uint64_t> data;
+
+    public:
+    /**
+     * @brief creates an empty packed vector
+     */
+    packed_vector();
+
+    /**
+     * @brief creates a packed vector of m zero-initialized values
+     * @param m number of values
+     * @param w width of each value in bits, 0 <= w <= 64
+     */
+    packed_vector(uint64_t m, uint8_t w);
+
+    /**
+     * @brief deletes the packed vector
+     */
+    ~packed_vector();
+
+    /**
+     * @brief creates a packed vector from an input stream
+     * @param in input stream
+     */
+    packed_vector(std::istream &in);
+
+    /**
+     * @brief writes the packed vector to an output stream
+     * @param out output stream
+     * @return size of the data written to out
+     */
+    uint64_t serialize(std::ostream &out) const;
+
+    /**
+     * @brief returns the number of values
+     * @return number of values
+     */
+    uint64_t size() const;
+
+    /**
+     * @brief returns the width of each value in bits
+     * @return width of each value in bits
+     */
+    uint8_t width() const;
+
+    /**
+     * @brief returns the minimum width, that is needed to store the values in [0..v]
+     * @param v maximum value
+     * @return minimum width in bits, at least 1
+     */
+    static uint8_t width_of(uint64_t v);
+
+    /**
+     * @brief returns the i-th value
+     * @param i in [0..m-1]
+     * @return i-th value
+     */
+    inline T get(uint64_t i) const;
+
+    /**
+     * @brief returns the i-th value
+     * @param i in [0..m-1]
+     * @return i-th value
+     */
+    inline T operator[](uint64_t i) const;
+
+    /**
+     * @brief sets the i-th value to v; values sharing a word must not be set concurrently
+     * @param i in [0..m-1]
+     * @param v in [0..2^w-1]
+     */
+    inline void set(uint64_t i, T v);
+};
\ No newline at end of file
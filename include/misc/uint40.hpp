@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief unsigned 40-bit integer stored in 5 bytes without padding, for positions in texts with up to 2^40
+ *        characters; it converts implicitly from and to uint64_t, so arithmetic is carried out in 64 bits
+ *        and only loads and stores touch the packed representation
+ */
+class __attribute__((packed)) uint40_t {
+    protected:
+    uint32_t lo; // lower 32 bits
+    uint8_t hi; // upper 8 bits
+
+    public:
+    /**
+     * @brief creates an uninitialized uint40_t
+     */
+    uint40_t() = default;
+
+    /**
+     * @brief creates a uint40_t out of the lower 40 bits of v
+     * @param v value
+     */
+    uint40_t(uint64_t v) : lo((uint32_t) v), hi((uint8_t) (v >> 32)) {}
+
+    /**
+     * @brief returns the value as a uint64_t
+     * @return value
+     */
+    operator uint64_t() const {
+        return (uint64_t) lo | ((uint64_t) hi << 32);
+    }
+
+    uint40_t& operator+=(uint64_t v) {return *this = uint64_t(*this)+v;}
+    uint40_t& operator-=(uint64_t v) {return *this = uint64_t(*this)-v;}
+    uint40_t& operator*=(uint64_t v) {return *this = uint64_t(*this)*v;}
+    uint40_t& operator++() {return *this += 1;}
+    uint40_t& operator--() {return *this -= 1;}
+    uint40_t operator++(int) {uint40_t v = *this; *this += 1; return v;}
+    uint40_t operator--(int) {uint40_t v = *this; *this -= 1; return v;}
+};
+
+static_assert(sizeof(uint40_t) == 5);
\ No newline at end of file
@@ -1,74 +1,476 @@
 #include <cassert>
 #include <iostream>
+#include <bit>
 
 #include <mds.hpp>
 
-template <typename T>
-mds<T>::mds() {}
+template <typename T, typename X>
+mds<T,X>::mds() {
+    n = 0;
+    k = 0;
+    fast = false;
+    t_exp = 0;
+}
 
-template <typename T>
-mds<T>::mds(std::vector<std::pair<T,T>> *I, T n, T a, int p, int v, bool log, std::ostream *os) {
+template <typename T, typename X>
+mds<T,X>::mds(std::vector<std::pair<T,T>> *I, T n, T a, int p, int v, bool log, std::ostream *os, T l_max) {
     this->n = n;
+    this->t_exp = 0;
     this->k = I->size();
+    this->fast = false;
     
     assert(0 < k && k <= n);
     assert(2 <= a);
     assert(1 <= p && p <= omp_get_max_threads() && (T) p <= n);
     assert((v == 1 && p == 1) || (v == 2 && p == 1) || v == 3 || (v == 4 && 2 <= p));
 
-    mdsb<T> mdsb(this,I,n,a,p,v,log,os);
+    mdsb<T,X> mdsb(this,I,n,a,p,v,log,os,NULL,l_max);
 }
 
-template <typename T>
-mds<T>::~mds() {}
+template <typename T, typename X>
+mds<T,X>::~mds() {}
+
+template <typename T, typename X>
+mds<T,X>::mds(std::istream &in) : mds() {
+    uint64_t header[4];
+    in.read((char*)&header[0],header_bytes);
+
+    if (!in.good() || !valid_header(&header[0])) {
+        in.setstate(std::ios::failbit);
+        return;
+    }
 
-template <typename T>
-mds<T>::mds(std::istream &in) {
-    in.read((char*)&n,sizeof(T));
-    in.read((char*)&k,sizeof(T));
+    fast = header[1] & 1;
+    n = header[2];
+    k = header[3];
 
     D_pair.resize(k+1);
     in.read((char*)&D_pair[0],2*(k+1)*sizeof(T));
 
+    char padding[8];
+    in.read(&padding[0],padding_bytes(k));
+
     D_index.resize(k);
-    in.read((char*)&D_index[0],k*sizeof(T));
+    in.read((char*)&D_index[0],k*sizeof(X));
 }
 
-template <typename T>
-uint64_t mds<T>::serialize(std::ostream &out) {
-    out.write((char*)&n,sizeof(T));
-    out.write((char*)&k,sizeof(T));
+template <typename T, typename X>
+uint64_t mds<T,X>::serialize(std::ostream &out) const {
+    uint64_t header[4] = {format_id,format_flags(fast),(uint64_t) n,(uint64_t) k};
+    char padding[8] = {0};
+
+    out.write((char*)&header[0],header_bytes);
     out.write((char*)&D_pair[0],2*(k+1)*sizeof(T));
-    out.write((char*)&D_index[0],k*sizeof(T));
+    out.write(&padding[0],padding_bytes(k));
+    out.write((char*)&D_index[0],k*sizeof(X));
+
+    return header_bytes+2*(k+1)*sizeof(T)+padding_bytes(k)+k*sizeof(X);
+}
+
+template <typename T, typename X>
+mds<T,X> mds<T,X>::inverse(T a, int p, int v, bool log, std::ostream *os, T l_max) const {
+    assert(2 <= a);
+    assert(1 <= p && p <= omp_get_max_threads() && (T) p <= n);
+    assert((v == 1 && p == 1) || (v == 2 && p == 1) || v == 3 || (v == 4 && 2 <= p));
+
+    // pi[r] = j <=> q_j is the r-th smallest output interval starting position; because q_j lies in the
+    // input interval D_index[j], pi is sorted by D_index with a counting sort
+    std::vector<X> C(k+1,0);
+    for (X j=0; j<k; j++) {
+        C[unflag(fast,D_index[j])+1]++;
+    }
+    for (X x=1; x<=k; x++) {
+        C[x] += C[x-1];
+    }
+    std::vector<X> pi(k);
+    for (X j=0; j<k; j++) {
+        pi[C[unflag(fast,D_index[j])]++] = j;
+    }
+
+    // now C[x] is the end of the bucket of x; sort the at most 2a output intervals in each bucket by q
+    #pragma omp parallel for num_threads(p)
+    for (X x=0; x<k; x++) {
+        X l = x == 0 ? 0 : C[x-1];
+        for (X r=l+1; r<C[x]; r++) {
+            X j = pi[r];
+            X s = r;
+            while (s > l && D_pair[pi[s-1]].second > D_pair[j].second) {
+                pi[s] = pi[s-1];
+                s--;
+            }
+            pi[s] = j;
+        }
+    }
+
+    // I_inv[r] = (q_{pi[r]},p_{pi[r]}) and pi_inv[i] = r <=> pi[r] = i, so pi_inv sorts I_inv by p_i
+    std::vector<std::pair<T,T>> *I_inv = new std::vector<std::pair<T,T>>(k);
+    std::vector<X> pi_inv(k);
+    #pragma omp parallel for num_threads(p)
+    for (X r=0; r<k; r++) {
+        I_inv->at(r) = std::make_pair(D_pair[pi[r]].second,D_pair[pi[r]].first);
+        pi_inv[pi[r]] = r;
+    }
+    pi.clear();
+    pi.shrink_to_fit();
+    C.clear();
+    C.shrink_to_fit();
+
+    mds<T,X> M_inv;
+    M_inv.n = n;
+    M_inv.k = k;
+    mdsb<T,X> mdsb(&M_inv,I_inv,n,a,p,v,log,os,&pi_inv,l_max);
 
-    return (3*k+4)*sizeof(T);
+    return M_inv;
 }
 
-template <typename T>
-T mds<T>::intervals() {
+template <typename T, typename X>
+X mds<T,X>::intervals() const {
     return k;
 }
 
-template <typename T>
-T mds<T>::max_value() {
+template <typename T, typename X>
+T mds<T,X>::max_value() const {
     return n;
 }
 
-template <typename T>
-std::pair<T,T>& mds<T>::pair(T i) {
+template <typename T, typename X>
+const std::pair<T,T>& mds<T,X>::pair(X i) const {
     return D_pair[i];
 }
 
-template <typename T>
-T mds<T>::index(T i) {
-    return D_index[i];
+template <typename T, typename X>
+X mds<T,X>::index(X i) const {
+    return unflag(fast,D_index[i]);
 }
 
-template <typename T>
-void mds<T>::move(std::pair<T,T> &ix) {
-    ix.first = D_pair[ix.second].second+(ix.first-D_pair[ix.second].first);
-    ix.second = D_index[ix.second];
-    while (ix.first >= D_pair[ix.second+1].first) {
-        ix.second++;
+template <typename T, typename X>
+void mds<T,X>::build_lut(int s, int p) {
+    if (s < 0) {
+        // choose the smallest s, so that the table has at most k+2 entries and fits in lut_bytes
+        s = 0;
+        while (((uint64_t) (n-1) >> s) > (uint64_t) k || (((uint64_t) (n-1) >> s)+2)*sizeof(X) > lut_bytes) {
+            s++;
+        }
     }
+    s_lut = s;
+
+    uint64_t b_max = ((uint64_t) (n-1) >> s_lut)+1;
+    D_lut.resize(b_max+1);
+
+    // D_lut[b] is found with a binary search over D_pair, because the table is at most as large as D_pair.
+    #pragma omp parallel for num_threads(p)
+    for (uint64_t b=0; b<=b_max; b++) {
+        if (b == b_max) {
+            D_lut[b] = k-1;
+            continue;
+        }
+
+        T i = (T) (b << s_lut);
+        X l = 0;
+        X r = k-1;
+        X m;
+        while (l != r) {
+            m = l+(r-l)/2+1;
+            if (D_pair[m].first > i) {
+                r = m-1;
+            } else {
+                l = m;
+            }
+        }
+        D_lut[b] = l;
+    }
+}
+
+template <typename T, typename X>
+typename mds<T,X>::query_ctx mds<T,X>::ctx() const {
+    return query_ctx{D_pair.data(),D_index.data(),D_lut.empty() ? NULL : D_lut.data(),s_lut,k,fast,t_exp};
+}
+
+template <typename T, typename X>
+X mds<T,X>::locate_interval(T i) const {
+    return locate_interval(ctx(),i);
+}
+
+template <typename T, typename X>
+X mds<T,X>::locate_interval(const query_ctx &c, T i) {
+    X l,r;
+
+    if (c.D_lut == NULL) {
+        l = 0;
+        r = c.k-1;
+    } else {
+        // the interval containing i lies between the intervals containing b * 2^s_lut and (b+1) * 2^s_lut
+        T b = i >> c.s_lut;
+        l = c.D_lut[b];
+        r = c.D_lut[b+1];
+
+        if (r-l <= 8) {
+            while (i >= c.D_pair[l+1].first) {
+                l++;
+            }
+
+            return l;
+        }
+    }
+
+    X m;
+    while (l != r) {
+        m = l+(r-l)/2+1;
+        if (c.D_pair[m].first > i) {
+            r = m-1;
+        } else {
+            l = m;
+        }
+    }
+
+    return l;
+}
+
+template <typename T, typename X>
+void mds<T,X>::set_exp_scan(T t) {
+    t_exp = t;
+}
+
+template <typename T, typename X>
+X mds<T,X>::scan(const query_ctx &c, T i, X x) {
+    if (c.t_exp == 0) {
+        while (i >= c.D_pair[x+1].first) {
+            x++;
+        }
+
+        return x;
+    }
+
+    for (T s=0; s<c.t_exp; s++) {
+        if (i < c.D_pair[x+1].first) return x;
+        x++;
+    }
+
+    // Find the maximum x' >= x with p_x' <= i by doubling the step width until p_{x+d} > i,
+    // then binary search in [x, x+d-1]. D_pair[k] = (n,n) bounds the search.
+    X d = 1;
+    while (d < c.k-x && c.D_pair[x+d].first <= i) {
+        x += d;
+        d *= 2;
+    }
+    X r = x+std::min<X>(d,c.k-x)-1;
+    X m;
+    while (x != r) {
+        m = x+(r-x)/2+1;
+        if (c.D_pair[m].first > i) {
+            r = m-1;
+        } else {
+            x = m;
+        }
+    }
+
+    return x;
+}
+
+template <typename T, typename X>
+void mds<T,X>::move(std::pair<T,X> &ix) const {
+    move(ctx(),ix);
+}
+
+template <typename T, typename X>
+void mds<T,X>::move_begin(const query_ctx &c, std::pair<T,X> &ix) {
+    ix.first = c.D_pair[ix.second].second+(ix.first-c.D_pair[ix.second].first);
+    ix.second = c.D_index[ix.second];
+}
+
+template <typename T, typename X>
+void mds<T,X>::move_end(const query_ctx &c, std::pair<T,X> &ix) {
+    ix.second = is_fast(c.fast,ix.second) ? unflag(c.fast,ix.second) : scan(c,ix.first,ix.second);
+}
+
+template <typename T, typename X>
+void mds<T,X>::move(const query_ctx &c, std::pair<T,X> &ix) {
+    move_begin(c,ix);
+    move_end(c,ix);
+}
+
+template <typename T, typename X>
+T mds<T,X>::move_run(std::pair<T,X> &ix) const {
+    return move_run(ctx(),ix);
+}
+
+template <typename T, typename X>
+T mds<T,X>::move_run(const query_ctx &c, std::pair<T,X> &ix) {
+    T l = c.D_pair[ix.second+1].first-ix.first;
+    move(c,ix);
+
+    return std::min<T>(l,c.D_pair[ix.second+1].first-ix.first);
+}
+
+template <typename T, typename X>
+void mds<T,X>::move(std::pair<T,X> *ix, uint64_t b) const {
+    move(ctx(),ix,b);
+}
+
+template <typename T, typename X>
+void mds<T,X>::move(const query_ctx &c, std::pair<T,X> *ix, uint64_t b) {
+    // The queries are processed in a pipeline of three stages, that are prefetch_dist queries apart:
+    // 1. prefetch D_pair[x] and D_index[x] for query j
+    // 2. calculate i' and D_index[x] for query j-prefetch_dist and prefetch D_pair[D_index[x]+1], if the
+    //    scan is needed; the fast_bit is kept in x until stage 3
+    // 3. scan to x' for query j-2*prefetch_dist
+    for (uint64_t j=0; j<b+2*prefetch_dist; j++) {
+        if (j < b) {
+            __builtin_prefetch(&c.D_pair[ix[j].second]);
+            __builtin_prefetch(&c.D_index[ix[j].second]);
+        }
+        if (prefetch_dist <= j && j-prefetch_dist < b) {
+            std::pair<T,X> &ix_ = ix[j-prefetch_dist];
+            move_begin(c,ix_);
+            if (!is_fast(c.fast,ix_.second)) __builtin_prefetch(&c.D_pair[ix_.second+1]);
+        }
+        if (2*prefetch_dist <= j) {
+            move_end(c,ix[j-2*prefetch_dist]);
+        }
+    }
+}
+
+template <typename T, typename X>
+void mds<T,X>::move_bulk(std::vector<std::pair<T,X>> &ix, bool ordered, int s) const {
+    uint64_t m = ix.size();
+    if (m == 0) return;
+
+    if (s < 0) {
+        // a bucket of 2^s intervals occupies 2^s*(2*sizeof(T)+sizeof(X)) bytes in D_pair and D_index,
+        // and on average 2^s*m/k pairs (and their original positions) fall into it
+        double b_int = 2*sizeof(T)+sizeof(X)+(m/(double) k)*(sizeof(std::pair<T,X>)+(ordered ? sizeof(uint64_t) : 0));
+        s = 0;
+        while ((2 << s)*b_int <= (1 << 18) && ((uint64_t) 2 << s) <= (uint64_t) k) {
+            s++;
+        }
+    }
+
+    std::vector<uint64_t> pos;
+    if (ordered) {
+        pos.resize(m);
+        for (uint64_t j=0; j<m; j++) {
+            pos[j] = j;
+        }
+    }
+
+    // sort the pairs by their buckets
+    radix_sort(ix,ordered ? &pos : NULL,[s](const std::pair<T,X> &ix_, uint64_t){
+        return (uint64_t) ix_.second >> s;
+    },std::bit_width((uint64_t) (k-1) >> s));
+
+    move(&ix[0],m);
+
+    if (ordered) {
+        // restore the original order by sorting the pairs by their original positions
+        radix_sort(ix,&pos,[](const std::pair<T,X>&, uint64_t j){
+            return j;
+        },std::bit_width(m-1));
+    }
+}
+
+template <typename T, typename X>
+template <typename K>
+void mds<T,X>::radix_sort(std::vector<std::pair<T,X>> &ix, std::vector<uint64_t> *pos, K key, uint8_t w) {
+    uint64_t m = ix.size();
+    std::vector<std::pair<T,X>> ix_b(m);
+    std::vector<uint64_t> pos_b(pos != NULL ? m : 0);
+    std::vector<uint64_t> C(((uint64_t) 1 << radix_bits)+1);
+
+    for (uint8_t o=0; o<w; o+=radix_bits) {
+        uint64_t mask = ((uint64_t) 1 << std::min<uint8_t>(radix_bits,w-o))-1;
+        auto digit = [&](uint64_t j){return (key(ix[j],pos != NULL ? (*pos)[j] : 0) >> o) & mask;};
+
+        // C[d] stores the number of pairs with a digit smaller than d
+        std::fill(C.begin(),C.end(),0);
+        for (uint64_t j=0; j<m; j++) {
+            C[digit(j)+1]++;
+        }
+        for (uint64_t d=1; d<=mask; d++) {
+            C[d] += C[d-1];
+        }
+
+        for (uint64_t j=0; j<m; j++) {
+            uint64_t c = C[digit(j)]++;
+            ix_b[c] = ix[j];
+            if (pos != NULL) pos_b[c] = (*pos)[j];
+        }
+
+        ix.swap(ix_b);
+        if (pos != NULL) pos->swap(pos_b);
+    }
+}
+
+template <typename T, typename X>
+void mds<T,X>::move_range(T l, T r, X x_l, std::vector<std::tuple<T,T,X>> &out) const {
+    T i = l;
+    X x = x_l;
+    uint64_t o = out.size();
+
+    while (true) {
+        // [i,e] is the intersection of [l,r] with the input interval [p_x, p_x + d_x - 1]
+        T e = std::min<T>(r,D_pair[x+1].first-1);
+
+        std::pair<T,X> ix{i,x};
+        move(ix);
+
+        // extend the previous triple, if the image of [i,e] directly follows its image
+        if (out.size() > o && ix.first == std::get<0>(out.back())+std::get<1>(out.back())) {
+            std::get<1>(out.back()) += e-i+1;
+        } else {
+            out.emplace_back(ix.first,e-i+1,ix.second);
+        }
+
+        if (e == r) break;
+
+        i = e+1;
+        x++;
+    }
+}
+
+template <typename T, typename X>
+std::pair<T,X> mds<T,X>::walk(std::pair<T,X> ix, uint64_t steps) const {
+    return walk(ctx(),ix,steps);
+}
+
+template <typename T, typename X>
+std::pair<T,X> mds<T,X>::walk(const query_ctx &c, std::pair<T,X> ix, uint64_t steps) {
+    T i = ix.first;
+    X x = ix.second;
+
+    for (uint64_t s=0; s<steps; s++) {
+        i = c.D_pair[x].second+(i-c.D_pair[x].first);
+        X x_f = c.D_index[x];
+        x = is_fast(c.fast,x_f) ? unflag(c.fast,x_f) : scan(c,i,x_f);
+    }
+
+    return std::pair<T,X>{i,x};
+}
+
+template <typename T, typename X>
+template <typename O>
+std::pair<T,X> mds<T,X>::walk(std::pair<T,X> ix, uint64_t steps, O out) const {
+    return walk(ctx(),ix,steps,out);
+}
+
+template <typename T, typename X>
+template <typename O>
+std::pair<T,X> mds<T,X>::walk(const query_ctx &c, std::pair<T,X> ix, uint64_t steps, O out) {
+    T i = ix.first;
+    X x = ix.second;
+
+    for (uint64_t s=0; s<=steps; s++) {
+        if constexpr (std::is_invocable_v<O,T,X>) {
+            out(i,x);
+        } else {
+            *out++ = i;
+        }
+
+        if (s == steps) break;
+
+        i = c.D_pair[x].second+(i-c.D_pair[x].first);
+        X x_f = c.D_index[x];
+        x = is_fast(c.fast,x_f) ? unflag(c.fast,x_f) : scan(c,i,x_f);
+    }
+
+    return std::pair<T,X>{i,x};
 }
\ No newline at end of file
@@ -0,0 +1,184 @@
+#include <iostream>
+#include <bit>
+
+#include <mds_blocked.hpp>
+
+template <typename T, uint64_t B>
+mds_blocked<T,B>::mds_blocked() {}
+
+template <typename T, uint64_t B>
+mds_blocked<T,B>::mds_blocked(const mds<T> &M) {
+    n = M.max_value();
+    k = M.intervals();
+
+    T b_max = k/B+1;
+    std::vector<block_header> H(b_max);
+
+    // calculate the bases and widths of each block and the number of words the largest block occupies
+    uint64_t s_max = 0;
+    #pragma omp parallel for reduction(max:s_max)
+    for (T b=0; b<b_max; b++) {
+        T l = b*B;
+        T r = std::min<T>(l+B,k+1);
+        // the entry k only stores p_k = n, its other differences are 0
+        T r_ = std::min<T>(r,k);
+
+        block_header &h = H[b];
+        h.p = M.pair(l).first;
+        h.q = r_ > l ? M.pair(l).second : 0;
+        h.x = r_ > l ? M.index(l) : 0;
+        T q_max = h.q;
+        T x_max = h.x;
+        for (T j=l+1; j<r_; j++) {
+            h.q = std::min<T>(h.q,M.pair(j).second);
+            h.x = std::min<T>(h.x,M.index(j));
+            q_max = std::max<T>(q_max,M.pair(j).second);
+            x_max = std::max<T>(x_max,M.index(j));
+        }
+
+        h.w_p = std::max<uint8_t>(1,std::bit_width((uint64_t) ((r == k+1 ? n : M.pair(r-1).first)-h.p)));
+        h.w_q = std::max<uint8_t>(1,std::bit_width((uint64_t) (q_max-h.q)));
+        h.w_x = std::max<uint8_t>(1,std::bit_width((uint64_t) (x_max-h.x)));
+        h.w = h.w_p+h.w_q+h.w_x;
+        s_max = std::max<uint64_t>(s_max,head_words+((r-l)*h.w+63)/64);
+    }
+    s_b = s_max;
+
+    // each block starts at a new word, so the blocks can be filled in parallel
+    D_data.resize(b_max*s_b+1,0);
+    #pragma omp parallel for
+    for (T b=0; b<b_max; b++) {
+        block_header &h = H[b];
+        T l = b*B;
+        T r = std::min<T>(l+B,k+1);
+        h.o = 64*(b*s_b+head_words);
+
+        uint64_t *d = &D_data[b*s_b];
+        d[0] = (uint64_t) h.p;
+        d[1] = (uint64_t) h.q;
+        d[2] = (uint64_t) h.x;
+        d[3] = (uint64_t) h.w_p | (uint64_t) h.w_q << 8 | (uint64_t) h.w_x << 16 | (uint64_t) h.w << 24;
+
+        for (T j=l; j<r; j++) {
+            uint64_t e = h.o+(j-l)*h.w;
+            if (j == k) {
+                set_bits(e,h.w_p,n-h.p);
+            } else {
+                set_bits(e,h.w_p,M.pair(j).first-h.p);
+                set_bits(e+h.w_p,h.w_q,M.pair(j).second-h.q);
+                set_bits(e+h.w_p+h.w_q,h.w_x,M.index(j)-h.x);
+            }
+        }
+    }
+}
+
+template <typename T, uint64_t B>
+mds_blocked<T,B>::mds_blocked(std::vector<std::pair<T,T>> *I, T n, T a, int p, int v, bool log, std::ostream *os) {
+    mds<T> M(I,n,a,p,v,log,os);
+    *this = mds_blocked<T,B>(M);
+}
+
+template <typename T, uint64_t B>
+mds_blocked<T,B>::~mds_blocked() {}
+
+template <typename T, uint64_t B>
+mds_blocked<T,B>::mds_blocked(std::istream &in) {
+    in.read((char*)&n,sizeof(T));
+    in.read((char*)&k,sizeof(T));
+
+    uint64_t s;
+    in.read((char*)&s,sizeof(uint64_t));
+    D_data.resize(s);
+    in.read((char*)&D_data[0],s*sizeof(uint64_t));
+
+    // D_data stores k/B+1 blocks of s_b words each and a zero word
+    s_b = (s-1)/(k/B+1);
+}
+
+template <typename T, uint64_t B>
+uint64_t mds_blocked<T,B>::serialize(std::ostream &out) const {
+    uint64_t s = D_data.size();
+
+    // s_b is not written, because it is calculated from the size of D_data
+    out.write((char*)&n,sizeof(T));
+    out.write((char*)&k,sizeof(T));
+    out.write((char*)&s,sizeof(uint64_t));
+    out.write((char*)&D_data[0],s*sizeof(uint64_t));
+
+    return 2*sizeof(T)+sizeof(uint64_t)+s*sizeof(uint64_t);
+}
+
+template <typename T, uint64_t B>
+typename mds_blocked<T,B>::block_header mds_blocked<T,B>::head(T b) const {
+    const uint64_t *d = &D_data[b*s_b];
+    return block_header{
+        (T) d[0],(T) d[1],(T) d[2],64*(b*s_b+head_words),
+        (uint8_t) d[3],(uint8_t) (d[3] >> 8),(uint8_t) (d[3] >> 16),(uint8_t) (d[3] >> 24)
+    };
+}
+
+template <typename T, uint64_t B>
+uint64_t mds_blocked<T,B>::get_bits(uint64_t b, uint8_t w) const {
+    uint64_t j = b >> 6;
+    uint64_t o = b & 63;
+    // the mask is built with two shifts, so that w = 64 is handled without an undefined shift
+    return ((D_data[j] >> o) | ((D_data[j+1] << 1) << (63-o))) & ((((uint64_t) 1 << (w-1)) << 1)-1);
+}
+
+template <typename T, uint64_t B>
+void mds_blocked<T,B>::set_bits(uint64_t b, uint8_t w, uint64_t v) {
+    uint64_t j = b >> 6;
+    uint64_t o = b & 63;
+    D_data[j] |= v << o;
+    if (o+w > 64) {
+        D_data[j+1] |= v >> (64-o);
+    }
+}
+
+template <typename T, uint64_t B>
+T mds_blocked<T,B>::intervals() const {
+    return k;
+}
+
+template <typename T, uint64_t B>
+T mds_blocked<T,B>::max_value() const {
+    return n;
+}
+
+template <typename T, uint64_t B>
+std::pair<T,T> mds_blocked<T,B>::pair(T x) const {
+    block_header h = head(x/B);
+    uint64_t e = h.o+(x%B)*h.w;
+    return std::pair<T,T>{h.p+get_bits(e,h.w_p),h.q+get_bits(e+h.w_p,h.w_q)};
+}
+
+template <typename T, uint64_t B>
+T mds_blocked<T,B>::index(T x) const {
+    block_header h = head(x/B);
+    return h.x+get_bits(h.o+(x%B)*h.w+h.w_p+h.w_q,h.w_x);
+}
+
+template <typename T, uint64_t B>
+void mds_blocked<T,B>::move(std::pair<T,T> &ix) const {
+    block_header h = head(ix.second/B);
+    uint64_t e = h.o+(ix.second%B)*h.w;
+
+    ix.first = h.q+get_bits(e+h.w_p,h.w_q)+(ix.first-h.p-get_bits(e,h.w_p));
+    ix.second = h.x+get_bits(e+h.w_p+h.w_q,h.w_x);
+
+    // scan the p_x' starting at x' = D_index[x] + 1 and decode the header only when entering a new block;
+    // the scan ends at the latest at p_k = n > i'
+    T x = ix.second+1;
+    h = head(x/B);
+    e = h.o+(x%B)*h.w;
+    while (ix.first >= (T) (h.p+get_bits(e,h.w_p))) {
+        x++;
+        if (x%B == 0) {
+            h = head(x/B);
+            e = h.o;
+        } else {
+            e += h.w;
+        }
+    }
+    ix.second = x-1;
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include <iostream>
+
+#include <ips4o.hpp>
+
+#include <mds_cl.hpp>
+
+template <typename T>
+mds_cl<T>::mds_cl() {}
+
+template <typename T>
+mds_cl<T>::mds_cl(const mds<T> &M) {
+    n = M.max_value();
+    k = M.intervals();
+
+    // sort the output intervals by their starting positions
+    std::vector<T> ord(k);
+    #pragma omp parallel for
+    for (T j=0; j<k; j++) {
+        ord[j] = j;
+    }
+    ips4o::parallel::sort(ord.begin(),ord.end(),[&M](T j1, T j2){return M.pair(j1).second < M.pair(j2).second;});
+
+    // slot_of[i] = slot, in which interval i has been placed last
+    std::vector<T> slot_of(k);
+    // D_index_slot[j] = slot, in which the scan of the move query for interval j starts
+    std::vector<T> D_index_slot(k);
+    // src[x] = interval stored in slot x, or k if x is a padding slot
+    std::vector<T> src;
+    src.reserve(k+k/B+B);
+
+    std::vector<std::pair<T,T>,cl_allocator<std::pair<T,T>>> D_pair_s;
+    D_pair_s.reserve(k+k/B+B);
+
+    // number of intervals placed so far, interval np is placed next
+    T np = 0;
+
+    auto place = [&](T i){
+        slot_of[i] = D_pair_s.size();
+        D_pair_s.emplace_back(M.pair(i));
+        src.emplace_back(i);
+    };
+
+    // fill the current block with pairs, whose starting position is the one of the interval placed next
+    auto pad = [&](){
+        T p_nxt = np < k ? M.pair(np).first : n;
+        while (D_pair_s.size() % B != 0) {
+            D_pair_s.emplace_back(std::pair<T,T>{p_nxt,p_nxt});
+            src.emplace_back(k);
+        }
+    };
+
+    // The input intervals connected to the output intervals in ascending order of their starting positions
+    // are consecutive, with the last one of an output interval possibly being the first one of the next.
+    for (T m=0; m<k; m++) {
+        T j = ord[m];
+        T s = M.index(j);
+        T qd = M.pair(j).second+(M.pair(j+1).first-M.pair(j).first);
+        T e = s;
+        while (M.pair(e+1).first < qd) {
+            e++;
+        }
+
+        T pos = D_pair_s.size();
+
+        if (s < np) {
+            // [p_s, p_s + d_s - 1] has already been placed in slot pos-1, which ends the scan of the preceding
+            // output interval; the slots of s+1..e and the slot after e must be in the block of slot pos-1
+            if ((pos+(e-s))/B != (pos-1)/B) {
+                pad();
+                place(s);
+            }
+        } else if (pos % B != 0 && (pos+(e-s+1))/B != pos/B) {
+            pad();
+        }
+
+        for (T i=np; i<=e; i++) {
+            place(i);
+        }
+        np = e+1;
+
+        D_index_slot[j] = slot_of[s];
+    }
+
+    // the sentinel (n,n) ends the scans of the last output interval
+    D_pair_s.emplace_back(std::pair<T,T>{n,n});
+    src.emplace_back(k);
+    pad();
+
+    k_s = D_pair_s.size();
+    D_pair = std::move(D_pair_s);
+    D_index.resize(k_s);
+
+    #pragma omp parallel for
+    for (T x=0; x<k_s; x++) {
+        D_index[x] = src[x] < k ? D_index_slot[src[x]] : 0;
+    }
+}
+
+template <typename T>
+mds_cl<T>::mds_cl(std::vector<std::pair<T,T>> *I, T n, T a, int p, int v, bool log, std::ostream *os) {
+    mds<T> M(I,n,a,p,v,log,os);
+    *this = mds_cl<T>(M);
+}
+
+template <typename T>
+mds_cl<T>::~mds_cl() {}
+
+template <typename T>
+mds_cl<T>::mds_cl(std::istream &in) {
+    in.read((char*)&n,sizeof(T));
+    in.read((char*)&k,sizeof(T));
+    in.read((char*)&k_s,sizeof(T));
+
+    D_pair.resize(k_s);
+    in.read((char*)&D_pair[0],2*k_s*sizeof(T));
+
+    D_index.resize(k_s);
+    in.read((char*)&D_index[0],k_s*sizeof(T));
+}
+
+template <typename T>
+uint64_t mds_cl<T>::serialize(std::ostream &out) const {
+    out.write((char*)&n,sizeof(T));
+    out.write((char*)&k,sizeof(T));
+    out.write((char*)&k_s,sizeof(T));
+    out.write((char*)&D_pair[0],2*k_s*sizeof(T));
+    out.write((char*)&D_index[0],k_s*sizeof(T));
+
+    return (3*k_s+3)*sizeof(T);
+}
+
+template <typename T>
+T mds_cl<T>::intervals() const {
+    return k;
+}
+
+template <typename T>
+T mds_cl<T>::slots() const {
+    return k_s;
+}
+
+template <typename T>
+T mds_cl<T>::max_value() const {
+    return n;
+}
+
+template <typename T>
+T mds_cl<T>::locate_slot(T i) const {
+    // The starting positions in the first slots of the blocks are non-decreasing, so find the last block
+    // starting with a starting position <= i and scan it.
+    T l = 0;
+    T r = k_s/B-1;
+    T m;
+    while (l != r) {
+        m = l+(r-l)/2+1;
+        if (D_pair[m*B].first > i) {
+            r = m-1;
+        } else {
+            l = m;
+        }
+    }
+
+    T x = l*B;
+    while ((x+1)%B != 0 && i >= D_pair[x+1].first) {
+        x++;
+    }
+
+    return x;
+}
+
+template <typename T>
+const std::pair<T,T>& mds_cl<T>::pair(T x) const {
+    return D_pair[x];
+}
+
+template <typename T>
+void mds_cl<T>::move(std::pair<T,T> &ix) const {
+    ix.first = D_pair[ix.second].second+(ix.first-D_pair[ix.second].first);
+    ix.second = D_index[ix.second];
+    while (ix.first >= D_pair[ix.second+1].first) {
+        ix.second++;
+    }
+}
\ No newline at end of file
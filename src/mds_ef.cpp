@@ -0,0 +1,86 @@
+#include <iostream>
+
+#include <mds_ef.hpp>
+
+template <typename T>
+mds_ef<T>::mds_ef() {}
+
+template <typename T>
+mds_ef<T>::mds_ef(const mds<T> &M) {
+    n = M.max_value();
+    k = M.intervals();
+
+    D_p = ef_vector<T>(k+1,n,[&M](uint64_t i){return M.pair(i).first;});
+    D_q = packed_vector<T>(k,packed_vector<T>::width_of(n-1));
+    D_index = packed_vector<T>(k,packed_vector<T>::width_of(k-1));
+
+    // D_p is encoded sequentially, D_q and D_index in blocks of 64 values, that occupy whole words
+    #pragma omp parallel for
+    for (T b=0; b<=k/64; b++) {
+        T e = std::min<T>((b+1)*64,k);
+        for (T i=b*64; i<e; i++) {
+            D_q.set(i,M.pair(i).second);
+            D_index.set(i,M.index(i));
+        }
+    }
+}
+
+template <typename T>
+mds_ef<T>::mds_ef(std::vector<std::pair<T,T>> *I, T n, T a, int p, int v, bool log, std::ostream *os) {
+    mds<T> M(I,n,a,p,v,log,os);
+    *this = mds_ef<T>(M);
+}
+
+template <typename T>
+mds_ef<T>::~mds_ef() {}
+
+template <typename T>
+mds_ef<T>::mds_ef(std::istream &in) {
+    in.read((char*)&n,sizeof(T));
+    in.read((char*)&k,sizeof(T));
+
+    D_p = ef_vector<T>(in);
+    D_q = packed_vector<T>(in);
+    D_index = packed_vector<T>(in);
+}
+
+template <typename T>
+uint64_t mds_ef<T>::serialize(std::ostream &out) const {
+    out.write((char*)&n,sizeof(T));
+    out.write((char*)&k,sizeof(T));
+
+    return 2*sizeof(T)+D_p.serialize(out)+D_q.serialize(out)+D_index.serialize(out);
+}
+
+template <typename T>
+T mds_ef<T>::intervals() const {
+    return k;
+}
+
+template <typename T>
+T mds_ef<T>::max_value() const {
+    return n;
+}
+
+template <typename T>
+std::pair<T,T> mds_ef<T>::pair(T x) const {
+    return std::pair<T,T>{D_p[x],D_q[x]};
+}
+
+template <typename T>
+T mds_ef<T>::index(T x) const {
+    return D_index[x];
+}
+
+template <typename T>
+void mds_ef<T>::move(std::pair<T,T> &ix) const {
+    ix.first = D_q[ix.second]+(ix.first-D_p[ix.second]);
+    ix.second = D_index[ix.second];
+
+    // the scan selects p_{x'+1} once and then iterates to the following starting positions
+    typename ef_vector<T>::ef_it it = D_p.iterator(ix.second+1);
+    while (ix.first >= it.current()) {
+        ix.second++;
+        it.next();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include <cassert>
+
+#include <mds_exec.hpp>
+
+template <typename T, typename X>
+mds_exec<T,X>::mds_exec(const mds<T,X> *M, int p, uint64_t b, uint64_t c) {
+    this->M = M;
+    this->p = p;
+    this->b = b;
+    this->c = c;
+    m = 0;
+    t = std::chrono::steady_clock::duration::zero();
+}
+
+template <typename T, typename X>
+mds_exec<T,X>::~mds_exec() {
+    M = NULL;
+}
+
+template <typename T, typename X>
+void mds_exec<T,X>::run_chunk(std::pair<T,X> *ix, uint64_t *steps, uint64_t s_all, uint64_t l, uint64_t r) {
+    const typename mds<T,X>::query_ctx ctx = M->ctx();
+
+    // query, remaining number of move queries and stage of each lane
+    std::vector<uint64_t> L_j(b);
+    std::vector<uint64_t> L_s(b);
+    std::vector<uint8_t> L_st(b);
+
+    uint64_t j_nxt = l;
+    uint64_t active = 0;
+
+    // assigns the next query with at least one move query left to lane i_l, returns false if there is none
+    auto refill = [&](uint64_t i_l){
+        while (j_nxt < r) {
+            uint64_t s = steps == NULL ? s_all : steps[j_nxt];
+            if (s != 0) {
+                L_j[i_l] = j_nxt++;
+                L_s[i_l] = s;
+                L_st[i_l] = 0;
+                return true;
+            }
+            j_nxt++;
+        }
+        return false;
+    };
+
+    for (uint64_t i_l=0; i_l<b; i_l++) {
+        if (!refill(i_l)) break;
+        active++;
+    }
+
+    // Each lane advances by one stage per round:
+    // 0. prefetch D_pair[x] and D_index[x]
+    // 1. calculate i' and D_index[x] and prefetch D_pair[D_index[x]+1], if the scan is needed
+    // 2. remove the fast_bit or scan to x'
+    while (active > 0) {
+        for (uint64_t i_l=0; i_l<active;) {
+            std::pair<T,X> &ix_ = ix[L_j[i_l]];
+
+            if (L_st[i_l] == 0) {
+                __builtin_prefetch(&ctx.D_pair[ix_.second]);
+                __builtin_prefetch(&ctx.D_index[ix_.second]);
+                L_st[i_l] = 1;
+            } else if (L_st[i_l] == 1) {
+                mds<T,X>::move_begin(ctx,ix_);
+                if (!mds<T,X>::is_fast(ctx.fast,ix_.second)) __builtin_prefetch(&ctx.D_pair[ix_.second+1]);
+                L_st[i_l] = 2;
+            } else {
+                mds<T,X>::move_end(ctx,ix_);
+                L_st[i_l] = 0;
+
+                if (--L_s[i_l] == 0 && !refill(i_l)) {
+                    // the lane has no queries left, so replace it by the last active lane
+                    active--;
+                    L_j[i_l] = L_j[active];
+                    L_s[i_l] = L_s[active];
+                    L_st[i_l] = L_st[active];
+                    continue;
+                }
+            }
+
+            i_l++;
+        }
+    }
+}
+
+template <typename T, typename X>
+void mds_exec<T,X>::run(std::pair<T,X> *ix, uint64_t *steps, uint64_t s_all, uint64_t q) {
+    m = 0;
+    t = std::chrono::steady_clock::duration::zero();
+    if (q == 0) return;
+
+    std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+
+    uint64_t chunks = (q+c-1)/c;
+    uint64_t moves = 0;
+
+    #pragma omp parallel for num_threads(p) schedule(dynamic) reduction(+:moves)
+    for (uint64_t i_c=0; i_c<chunks; i_c++) {
+        uint64_t l = i_c*c;
+        uint64_t r = std::min(l+c,q);
+
+        run_chunk(ix,steps,s_all,l,r);
+
+        if (steps == NULL) {
+            moves += (r-l)*s_all;
+        } else {
+            for (uint64_t j=l; j<r; j++) {
+                moves += steps[j];
+            }
+        }
+    }
+
+    m = moves;
+    t = std::chrono::steady_clock::now()-time;
+}
+
+template <typename T, typename X>
+void mds_exec<T,X>::run(std::vector<std::pair<T,X>> &ix, std::vector<uint64_t> &steps) {
+    assert(steps.size() == ix.size());
+
+    run(ix.data(),steps.data(),0,ix.size());
+}
+
+template <typename T, typename X>
+void mds_exec<T,X>::run(std::vector<std::pair<T,X>> &ix, uint64_t steps) {
+    run(ix.data(),NULL,steps,ix.size());
+}
+
+template <typename T, typename X>
+uint64_t mds_exec<T,X>::moves() {
+    return m;
+}
+
+template <typename T, typename X>
+double mds_exec<T,X>::runtime() {
+    return std::chrono::duration<double,std::milli>(t).count();
+}
+
+template <typename T, typename X>
+double mds_exec<T,X>::throughput() {
+    double s = std::chrono::duration<double>(t).count();
+    return s > 0 ? m/s : 0;
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#include <mds_fixed.hpp>
+
+template <typename T, uint64_t A>
+mds_fixed<T,A>::mds_fixed() {}
+
+template <typename T, uint64_t A>
+mds_fixed<T,A>::mds_fixed(std::vector<std::pair<T,T>> *I, T n, int p, int v, bool log, std::ostream *os)
+    : mds<T>(I,n,A,p,v,log,os) {
+    pad_dpair();
+}
+
+template <typename T, uint64_t A>
+mds_fixed<T,A>::mds_fixed(std::istream &in) : mds<T>(in) {
+    pad_dpair();
+}
+
+template <typename T, uint64_t A>
+void mds_fixed<T,A>::pad_dpair() {
+    this->D_pair.resize(this->k+2*A-1,std::pair<T,T>{this->n,this->n});
+}
+
+template <typename T, uint64_t A>
+void mds_fixed<T,A>::move(std::pair<T,T> &ix) const {
+    ix.first = this->D_pair[ix.second].second+(ix.first-this->D_pair[ix.second].first);
+    T x = this->D_index[ix.second];
+    if (mds<T>::is_fast(this->fast,x)) {
+        ix.second = mds<T>::unflag(this->fast,x);
+        return;
+    }
+
+    // Because p_{x+1} < p_{x+2} < ..., x' - x is the number of starting positions <= i' in D_pair[x+1..x+2A-1].
+    T c = 0;
+    for (uint64_t t=1; t<=2*A-1; t++) {
+        c += this->D_pair[x+t].first <= ix.first;
+    }
+    ix.second = x+c;
+}
\ No newline at end of file
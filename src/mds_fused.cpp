@@ -0,0 +1,73 @@
+#include <iostream>
+
+#include <mds_fused.hpp>
+
+template <typename T>
+mds_fused<T>::mds_fused() {}
+
+template <typename T>
+mds_fused<T>::mds_fused(const mds<T> &M) {
+    n = M.max_value();
+    k = M.intervals();
+
+    D_rec.resize(k+1);
+
+    #pragma omp parallel for
+    for (T i=0; i<k; i++) {
+        D_rec[i] = interv_rec{M.pair(i).first,M.pair(i).second,M.index(i)};
+    }
+
+    D_rec[k] = interv_rec{n,n,0};
+}
+
+template <typename T>
+mds_fused<T>::mds_fused(std::vector<std::pair<T,T>> *I, T n, T a, int p, int v, bool log, std::ostream *os) {
+    mds<T> M(I,n,a,p,v,log,os);
+    *this = mds_fused<T>(M);
+}
+
+template <typename T>
+mds_fused<T>::~mds_fused() {}
+
+template <typename T>
+mds_fused<T>::mds_fused(std::istream &in) {
+    in.read((char*)&n,sizeof(T));
+    in.read((char*)&k,sizeof(T));
+
+    D_rec.resize(k+1);
+    in.read((char*)&D_rec[0],(k+1)*sizeof(interv_rec));
+}
+
+template <typename T>
+uint64_t mds_fused<T>::serialize(std::ostream &out) const {
+    out.write((char*)&n,sizeof(T));
+    out.write((char*)&k,sizeof(T));
+    out.write((char*)&D_rec[0],(k+1)*sizeof(interv_rec));
+
+    return 2*sizeof(T)+(k+1)*sizeof(interv_rec);
+}
+
+template <typename T>
+T mds_fused<T>::intervals() const {
+    return k;
+}
+
+template <typename T>
+T mds_fused<T>::max_value() const {
+    return n;
+}
+
+template <typename T>
+const typename mds_fused<T>::interv_rec& mds_fused<T>::record(T i) const {
+    return D_rec[i];
+}
+
+template <typename T>
+void mds_fused<T>::move(std::pair<T,T> &ix) const {
+    const interv_rec &rec = D_rec[ix.second];
+    ix.first = rec.q+(ix.first-rec.p);
+    ix.second = rec.idx;
+    while (ix.first >= D_rec[ix.second+1].p) {
+        ix.second++;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <mds_mmap.hpp>
+
+template <typename T, typename X>
+mds_mmap<T,X>::mds_mmap() {
+    addr = NULL;
+    len = 0;
+}
+
+template <typename T, typename X>
+mds_mmap<T,X>::mds_mmap(const std::string &path, bool populate, bool hugepages) {
+    addr = NULL;
+    len = 0;
+
+    int fd = open(path.c_str(),O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat st;
+    if (fstat(fd,&st) != 0 || (uint64_t) st.st_size < mds_view<T,X>::size_in_bytes(0)) {
+        close(fd);
+        return;
+    }
+
+    len = st.st_size;
+    void *m = mmap(NULL,len,PROT_READ,MAP_SHARED|(populate ? MAP_POPULATE : 0),fd,0);
+    // the mapping stays valid after closing the file descriptor
+    close(fd);
+    if (m == MAP_FAILED) {
+        len = 0;
+        return;
+    }
+    addr = m;
+
+    if (populate) {
+        madvise(addr,len,MADV_WILLNEED);
+    } else {
+        // move queries access D_pair and D_index at random positions, so readahead only wastes memory
+        madvise(addr,len,MADV_RANDOM);
+    }
+    #ifdef MADV_HUGEPAGE
+    if (hugepages) {
+        madvise(addr,len,MADV_HUGEPAGE);
+    }
+    #endif
+
+    // files in another format or written for other types T or X are rejected
+    if (!mds_view<T,X>::valid_header(addr)) {
+        unmap();
+        return;
+    }
+
+    // mmap returns page aligned memory, so the serialized arrays are aligned as in the file
+    mds_view<T,X>::operator=(mds_view<T,X>(addr));
+
+    // k is read from the file, so it is checked against len by a division before size_in_bytes() is
+    // calculated, which may overflow for a corrupt k
+    uint64_t len_min = mds_view<T,X>::size_in_bytes(0);
+    if (this->c.k == 0 ||
+        (uint64_t) this->c.k > (len-len_min)/(2*sizeof(T)+sizeof(X)) ||
+        this->size_in_bytes() > len
+    ) {
+        unmap();
+    }
+}
+
+template <typename T, typename X>
+mds_mmap<T,X>::mds_mmap(mds_mmap &&other) : mds_view<T,X>(other) {
+    addr = other.addr;
+    len = other.len;
+    other.addr = NULL;
+    other.len = 0;
+    other.mds_view<T,X>::operator=(mds_view<T,X>());
+}
+
+template <typename T, typename X>
+mds_mmap<T,X>& mds_mmap<T,X>::operator=(mds_mmap &&other) {
+    if (this != &other) {
+        unmap();
+        mds_view<T,X>::operator=(other);
+        addr = other.addr;
+        len = other.len;
+        other.addr = NULL;
+        other.len = 0;
+        other.mds_view<T,X>::operator=(mds_view<T,X>());
+    }
+
+    return *this;
+}
+
+template <typename T, typename X>
+mds_mmap<T,X>::~mds_mmap() {
+    unmap();
+}
+
+template <typename T, typename X>
+void mds_mmap<T,X>::unmap() {
+    if (addr != NULL) {
+        munmap(addr,len);
+    }
+
+    addr = NULL;
+    len = 0;
+    mds_view<T,X>::operator=(mds_view<T,X>());
+}
+
+template <typename T, typename X>
+bool mds_mmap<T,X>::good() const {
+    return addr != NULL;
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include <iostream>
+
+#include <mds_offset.hpp>
+
+template <typename T>
+mds_offset<T>::mds_offset() {}
+
+template <typename T>
+mds_offset<T>::mds_offset(const mds<T> &M) {
+    n = M.max_value();
+    k = M.intervals();
+
+    // o_max is the largest offset q_j - p_{D_index[j]}
+    T o_max = 0;
+    #pragma omp parallel for reduction(max:o_max)
+    for (T j=0; j<k; j++) {
+        o_max = std::max<T>(o_max,M.pair(j).second-M.pair(M.index(j)).first);
+    }
+
+    D_p = packed_vector<T>(k+1,packed_vector<T>::width_of(n));
+    D_offs = packed_vector<T>(k,packed_vector<T>::width_of(o_max));
+    D_index = packed_vector<T>(k,packed_vector<T>::width_of(k-1));
+
+    // 64 consecutive values occupy whole words, so each thread fills blocks of 64 values
+    #pragma omp parallel for
+    for (T b=0; b<=k/64; b++) {
+        T e = std::min<T>((b+1)*64,k);
+        for (T i=b*64; i<e; i++) {
+            D_p.set(i,M.pair(i).first);
+            D_offs.set(i,M.pair(i).second-M.pair(M.index(i)).first);
+            D_index.set(i,M.index(i));
+        }
+    }
+
+    D_p.set(k,n);
+}
+
+template <typename T>
+mds_offset<T>::mds_offset(std::vector<std::pair<T,T>> *I, T n, T a, int p, int v, bool log, std::ostream *os) {
+    mds<T> M(I,n,a,p,v,log,os);
+    *this = mds_offset<T>(M);
+}
+
+template <typename T>
+mds_offset<T>::~mds_offset() {}
+
+template <typename T>
+mds_offset<T>::mds_offset(std::istream &in) {
+    in.read((char*)&n,sizeof(T));
+    in.read((char*)&k,sizeof(T));
+
+    D_p = packed_vector<T>(in);
+    D_offs = packed_vector<T>(in);
+    D_index = packed_vector<T>(in);
+}
+
+template <typename T>
+uint64_t mds_offset<T>::serialize(std::ostream &out) const {
+    out.write((char*)&n,sizeof(T));
+    out.write((char*)&k,sizeof(T));
+
+    return 2*sizeof(T)+D_p.serialize(out)+D_offs.serialize(out)+D_index.serialize(out);
+}
+
+template <typename T>
+T mds_offset<T>::intervals() const {
+    return k;
+}
+
+template <typename T>
+T mds_offset<T>::max_value() const {
+    return n;
+}
+
+template <typename T>
+std::pair<T,T> mds_offset<T>::pair(T x) const {
+    return std::pair<T,T>{D_p[x],D_p[D_index[x]]+D_offs[x]};
+}
+
+template <typename T>
+T mds_offset<T>::offset(T x) const {
+    return D_offs[x];
+}
+
+template <typename T>
+T mds_offset<T>::index(T x) const {
+    return D_index[x];
+}
+
+template <typename T>
+void mds_offset<T>::move(std::pair<T,T> &ix) const {
+    // p_{D_index[x]} lies next to p_{D_index[x]+1}, which the scan reads first
+    T x_ = D_index[ix.second];
+    ix.first = D_p[x_]+D_offs[ix.second]+(ix.first-D_p[ix.second]);
+    ix.second = x_;
+    while (ix.first >= D_p[ix.second+1]) {
+        ix.second++;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include <iostream>
+
+#include <mds_packed.hpp>
+
+template <typename T>
+mds_packed<T>::mds_packed() {}
+
+template <typename T>
+mds_packed<T>::mds_packed(const mds<T> &M) {
+    n = M.max_value();
+    k = M.intervals();
+
+    D_p = packed_vector<T>(k+1,packed_vector<T>::width_of(n));
+    D_q = packed_vector<T>(k,packed_vector<T>::width_of(n-1));
+    D_index = packed_vector<T>(k,packed_vector<T>::width_of(k-1));
+
+    // 64 consecutive values occupy whole words, so each thread fills blocks of 64 values
+    #pragma omp parallel for
+    for (T b=0; b<=k/64; b++) {
+        T e = std::min<T>((b+1)*64,k);
+        for (T i=b*64; i<e; i++) {
+            D_p.set(i,M.pair(i).first);
+            D_q.set(i,M.pair(i).second);
+            D_index.set(i,M.index(i));
+        }
+    }
+
+    D_p.set(k,n);
+}
+
+template <typename T>
+mds_packed<T>::mds_packed(std::vector<std::pair<T,T>> *I, T n, T a, int p, int v, bool log, std::ostream *os) {
+    mds<T> M(I,n,a,p,v,log,os);
+    *this = mds_packed<T>(M);
+}
+
+template <typename T>
+mds_packed<T>::~mds_packed() {}
+
+template <typename T>
+mds_packed<T>::mds_packed(std::istream &in) {
+    in.read((char*)&n,sizeof(T));
+    in.read((char*)&k,sizeof(T));
+
+    D_p = packed_vector<T>(in);
+    D_q = packed_vector<T>(in);
+    D_index = packed_vector<T>(in);
+}
+
+template <typename T>
+uint64_t mds_packed<T>::serialize(std::ostream &out) const {
+    out.write((char*)&n,sizeof(T));
+    out.write((char*)&k,sizeof(T));
+
+    return 2*sizeof(T)+D_p.serialize(out)+D_q.serialize(out)+D_index.serialize(out);
+}
+
+template <typename T>
+T mds_packed<T>::intervals() const {
+    return k;
+}
+
+template <typename T>
+T mds_packed<T>::max_value() const {
+    return n;
+}
+
+template <typename T>
+std::pair<T,T> mds_packed<T>::pair(T x) const {
+    return std::pair<T,T>{D_p[x],D_q[x]};
+}
+
+template <typename T>
+T mds_packed<T>::index(T x) const {
+    return D_index[x];
+}
+
+template <typename T>
+void mds_packed<T>::move(std::pair<T,T> &ix) const {
+    ix.first = D_q[ix.second]+(ix.first-D_p[ix.second]);
+    ix.second = D_index[ix.second];
+    while (ix.first >= D_p[ix.second+1]) {
+        ix.second++;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include <mds_sched.hpp>
+
+template <typename T, typename X>
+mds_sched<T,X>::walker::walker(std::coroutine_handle<promise_type> h) {
+    this->h = h;
+}
+
+template <typename T, typename X>
+mds_sched<T,X>::walker::walker(walker &&w) {
+    h = w.h;
+    w.h = NULL;
+}
+
+template <typename T, typename X>
+mds_sched<T,X>::walker::~walker() {
+    if (h) h.destroy();
+}
+
+template <typename T, typename X>
+typename mds_sched<T,X>::walker& mds_sched<T,X>::walker::operator=(walker &&w) {
+    if (h) h.destroy();
+    h = w.h;
+    w.h = NULL;
+    return *this;
+}
+
+template <typename T, typename X>
+bool mds_sched<T,X>::walker::resume() {
+    h.resume();
+    return !h.done();
+}
+
+template <typename T, typename X>
+mds_sched<T,X>::mds_sched(const mds<T,X> *M) {
+    this->M = M;
+}
+
+template <typename T, typename X>
+mds_sched<T,X>::~mds_sched() {
+    M = NULL;
+}
+
+template <typename T, typename X>
+void mds_sched<T,X>::add(walker &&w) {
+    W.emplace_back(std::move(w));
+}
+
+template <typename T, typename X>
+void mds_sched<T,X>::run() {
+    while (!W.empty()) {
+        for (uint64_t i=0; i<W.size();) {
+            if (W[i].resume()) {
+                i++;
+            } else {
+                // replace the finished walker by the last one
+                W[i] = std::move(W.back());
+                W.pop_back();
+            }
+        }
+    }
+}
+
+template <typename T, typename X>
+typename mds_sched<T,X>::walker mds_sched<T,X>::walk(std::pair<T,X> &ix, uint64_t steps) {
+    return walk_strided(&ix,1,1,steps);
+}
+
+template <typename T, typename X>
+typename mds_sched<T,X>::walker mds_sched<T,X>::walk_strided(std::pair<T,X> *ix, uint64_t m, uint64_t w, uint64_t steps) {
+    const typename mds<T,X>::query_ctx c = M->ctx();
+
+    for (uint64_t j=0; j<m; j+=w) {
+        std::pair<T,X> &ix_ = ix[j];
+
+        for (uint64_t s=0; s<steps; s++) {
+            co_await prefetch{&c.D_pair[ix_.second],&c.D_index[ix_.second]};
+            mds<T,X>::move_begin(c,ix_);
+            if (!mds<T,X>::is_fast(c.fast,ix_.second)) co_await prefetch{&c.D_pair[ix_.second+1],NULL};
+            mds<T,X>::move_end(c,ix_);
+        }
+    }
+}
+
+template <typename T, typename X>
+void mds_sched<T,X>::walk(std::vector<std::pair<T,X>> &ix, uint64_t steps, uint64_t w) {
+    w = std::min(w,(uint64_t) ix.size());
+
+    for (uint64_t l=0; l<w; l++) {
+        add(walk_strided(&ix[l],ix.size()-l,w,steps));
+    }
+
+    run();
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include <iostream>
+
+#include <mds_simd.hpp>
+
+template <typename T>
+mds_simd<T>::mds_simd() {}
+
+template <typename T>
+mds_simd<T>::mds_simd(const mds<T> &M) {
+    n = M.max_value();
+    k = M.intervals();
+
+    D_p.resize(k+1+simd_width,n);
+    D_q.resize(k);
+    D_index.resize(k);
+
+    #pragma omp parallel for
+    for (T i=0; i<k; i++) {
+        D_p[i] = M.pair(i).first;
+        D_q[i] = M.pair(i).second;
+        D_index[i] = M.index(i);
+    }
+}
+
+template <typename T>
+mds_simd<T>::mds_simd(std::vector<std::pair<T,T>> *I, T n, T a, int p, int v, bool log, std::ostream *os) {
+    mds<T> M(I,n,a,p,v,log,os);
+    *this = mds_simd<T>(M);
+}
+
+template <typename T>
+mds_simd<T>::~mds_simd() {}
+
+template <typename T>
+mds_simd<T>::mds_simd(std::istream &in) {
+    in.read((char*)&n,sizeof(T));
+    in.read((char*)&k,sizeof(T));
+
+    D_p.resize(k+1+simd_width,n);
+    in.read((char*)&D_p[0],k*sizeof(T));
+
+    D_q.resize(k);
+    in.read((char*)&D_q[0],k*sizeof(T));
+
+    D_index.resize(k);
+    in.read((char*)&D_index[0],k*sizeof(T));
+}
+
+template <typename T>
+uint64_t mds_simd<T>::serialize(std::ostream &out) const {
+    out.write((char*)&n,sizeof(T));
+    out.write((char*)&k,sizeof(T));
+    out.write((char*)&D_p[0],k*sizeof(T));
+    out.write((char*)&D_q[0],k*sizeof(T));
+    out.write((char*)&D_index[0],k*sizeof(T));
+
+    return (3*k+2)*sizeof(T);
+}
+
+template <typename T>
+T mds_simd<T>::intervals() const {
+    return k;
+}
+
+template <typename T>
+T mds_simd<T>::max_value() const {
+    return n;
+}
+
+template <typename T>
+T mds_simd<T>::scan(T i, T x) const {
+    // Because p_{x+1} < p_{x+2} < ..., the starting positions <= i in D_p[x+1..x+simd_width] form a prefix of it,
+    // so x can be advanced by the number of them. D_p[k..k+simd_width] = n > i makes the loads safe.
+    #if defined(__AVX512F__)
+    if constexpr (sizeof(T) == 8) {
+        __m512i v_i = _mm512_set1_epi64(i);
+        while (true) {
+            __m512i v_p = _mm512_loadu_si512(&D_p[x+1]);
+            __mmask8 msk = std::is_signed_v<T> ? _mm512_cmple_epi64_mask(v_p,v_i) : _mm512_cmple_epu64_mask(v_p,v_i);
+            int c = __builtin_popcount(msk);
+            x += c;
+            if (c < (int) simd_width) return x;
+        }
+    } else if constexpr (sizeof(T) == 4) {
+        __m512i v_i = _mm512_set1_epi32(i);
+        while (true) {
+            __m512i v_p = _mm512_loadu_si512(&D_p[x+1]);
+            __mmask16 msk = std::is_signed_v<T> ? _mm512_cmple_epi32_mask(v_p,v_i) : _mm512_cmple_epu32_mask(v_p,v_i);
+            int c = __builtin_popcount(msk);
+            x += c;
+            if (c < (int) simd_width) return x;
+        }
+    }
+    #elif defined(__AVX2__)
+    if constexpr (sizeof(T) == 8 || sizeof(T) == 4) {
+        // AVX2 only compares signed integers, so flip the sign bits of unsigned values
+        __m256i v_s = std::is_signed_v<T> ? _mm256_setzero_si256() :
+            (sizeof(T) == 8 ? _mm256_set1_epi64x(INT64_MIN) : _mm256_set1_epi32(INT32_MIN));
+        __m256i v_i = _mm256_xor_si256(sizeof(T) == 8 ? _mm256_set1_epi64x(i) : _mm256_set1_epi32(i),v_s);
+        while (true) {
+            __m256i v_p = _mm256_xor_si256(_mm256_loadu_si256((__m256i*)&D_p[x+1]),v_s);
+            // bit mask of the bytes of the starting positions > i
+            int msk = _mm256_movemask_epi8(sizeof(T) == 8 ? _mm256_cmpgt_epi64(v_p,v_i) : _mm256_cmpgt_epi32(v_p,v_i));
+            int c = __builtin_popcount(~msk)/sizeof(T);
+            x += c;
+            if (c < (int) simd_width) return x;
+        }
+    }
+    #endif
+
+    while (i >= D_p[x+1]) {
+        x++;
+    }
+
+    return x;
+}
+
+template <typename T>
+void mds_simd<T>::move(std::pair<T,T> &ix) const {
+    ix.first = D_q[ix.second]+(ix.first-D_p[ix.second]);
+    ix.second = scan(ix.first,D_index[ix.second]);
+}
\ No newline at end of file
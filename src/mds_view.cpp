@@ -0,0 +1,101 @@
+#include <mds_view.hpp>
+
+template <typename T, typename X>
+mds_view<T,X>::mds_view() {
+    n = 0;
+    c = typename mds<T,X>::query_ctx{NULL,NULL,NULL,0,0,false,0};
+}
+
+template <typename T, typename X>
+mds_view<T,X>::mds_view(const mds<T,X> &M) {
+    n = M.n;
+    c = M.ctx();
+}
+
+template <typename T, typename X>
+mds_view<T,X>::mds_view(const void *buf) {
+    // the layout written by mds<T,X>::serialize: format_id, flags, n, k, D_pair[0..k], padding, D_index[0..k-1]
+    const uint64_t *header = (const uint64_t*) buf;
+    n = header[2];
+    X k = header[3];
+    const char *D_pair = (const char*) buf+mds<T,X>::header_bytes;
+    const char *D_index = D_pair+2*((uint64_t) k+1)*sizeof(T)+mds<T,X>::padding_bytes(k);
+    c = typename mds<T,X>::query_ctx{(const std::pair<T,T>*) D_pair,(const X*) D_index,NULL,0,k,(bool) (header[1] & 1),0};
+}
+
+template <typename T, typename X>
+mds_view<T,X>::mds_view(T n, X k, const std::pair<T,T> *D_pair, const X *D_index, bool fast) {
+    this->n = n;
+    c = typename mds<T,X>::query_ctx{D_pair,D_index,NULL,0,k,fast,0};
+}
+
+template <typename T, typename X>
+bool mds_view<T,X>::valid_header(const void *buf) {
+    return mds<T,X>::valid_header((const uint64_t*) buf);
+}
+
+template <typename T, typename X>
+uint64_t mds_view<T,X>::size_in_bytes(X k) {
+    return mds<T,X>::header_bytes+2*((uint64_t) k+1)*sizeof(T)+mds<T,X>::padding_bytes(k)+(uint64_t) k*sizeof(X);
+}
+
+template <typename T, typename X>
+uint64_t mds_view<T,X>::size_in_bytes() const {
+    return size_in_bytes(c.k);
+}
+
+template <typename T, typename X>
+X mds_view<T,X>::intervals() const {
+    return c.k;
+}
+
+template <typename T, typename X>
+T mds_view<T,X>::max_value() const {
+    return n;
+}
+
+template <typename T, typename X>
+const std::pair<T,T>& mds_view<T,X>::pair(X i) const {
+    return c.D_pair[i];
+}
+
+template <typename T, typename X>
+X mds_view<T,X>::index(X i) const {
+    return mds<T,X>::unflag(c.fast,c.D_index[i]);
+}
+
+template <typename T, typename X>
+void mds_view<T,X>::set_exp_scan(T t) {
+    c.t_exp = t;
+}
+
+template <typename T, typename X>
+X mds_view<T,X>::locate_interval(T i) const {
+    return mds<T,X>::locate_interval(c,i);
+}
+
+template <typename T, typename X>
+void mds_view<T,X>::move(std::pair<T,X> &ix) const {
+    mds<T,X>::move(c,ix);
+}
+
+template <typename T, typename X>
+T mds_view<T,X>::move_run(std::pair<T,X> &ix) const {
+    return mds<T,X>::move_run(c,ix);
+}
+
+template <typename T, typename X>
+void mds_view<T,X>::move(std::pair<T,X> *ix, uint64_t b) const {
+    mds<T,X>::move(c,ix,b);
+}
+
+template <typename T, typename X>
+std::pair<T,X> mds_view<T,X>::walk(std::pair<T,X> ix, uint64_t steps) const {
+    return mds<T,X>::walk(c,ix,steps);
+}
+
+template <typename T, typename X>
+template <typename O>
+std::pair<T,X> mds_view<T,X>::walk(std::pair<T,X> ix, uint64_t steps, O out) const {
+    return mds<T,X>::walk(c,ix,steps,out);
+}
\ No newline at end of file
@@ -21,8 +21,8 @@ extern "C" {
 #include "mdsb_v3_seq.cpp"
 #include "mdsb_v4_par.cpp"
 
-template <typename T>
-mdsb<T>::mdsb(mds<T> *md, interv_seq<T> *I, T n, T a, int p, int v, bool log, std::ostream *os) {
+template <typename T, typename X>
+mdsb<T,X>::mdsb(mds<T,X> *md, interv_seq<T> *I, T n, T a, int p, int v, bool log, std::ostream *os, std::vector<X> *pi_I, T l_max) {
     this->md = md;
     this->n = n;
     this->k = I->size();
@@ -31,10 +31,29 @@ mdsb<T>::mdsb(mds<T> *md, interv_seq<T> *I, T n, T a, int p, int v, bool log, st
 
     omp_set_num_threads(p);
 
+    if (l_max > 0) {
+        X k_I = k;
+        split_intervals(I,l_max,pi_I);
+
+        if (log) {
+            if (os != NULL) {
+                *os << " l_max=" << l_max << " k_split=" << k;
+            }
+            std::cout << "split input intervals longer than " << l_max << ": " << k_I << " -> " << k << " intervals" << std::endl;
+        }
+    }
+
     if (v == 1) {
         build_v1(I,log,os);
     } else {
-        build_v2_v3_v4(I,v,log,os);
+        build_v2_v3_v4(I,v,log,os,pi_I);
+    }
+
+    if (log) {
+        if (os != NULL) {
+            *os << " k_=" << k;
+        }
+        std::cout << "the balanced interval sequence has k' = " << k << " intervals" << std::endl;
     }
 
     #ifndef NDEBUG
@@ -42,13 +61,63 @@ mdsb<T>::mdsb(mds<T> *md, interv_seq<T> *I, T n, T a, int p, int v, bool log, st
     #endif
 }
 
-template <typename T>
-mdsb<T>::~mdsb() {
+template <typename T, typename X>
+mdsb<T,X>::~mdsb() {
     md = NULL;
 }
 
-template <typename T>
-void mdsb<T>::build_v2_v3_v4(interv_seq<T> *I, int v, bool log, std::ostream *os) {
+template <typename T, typename X>
+void mdsb<T,X>::split_intervals(interv_seq<T> *I, T l_max, std::vector<X> *pi_I) {
+    // P[i] stores the number of intervals, the input intervals before [p_i, p_i + d_i - 1] are split into
+    std::vector<X> P(k+1);
+    P[0] = 0;
+    for (X i=0; i<k; i++) {
+        T d_i = (i == k-1 ? n : I->at(i+1).first) - I->at(i).first;
+        P[i+1] = P[i] + 1 + (d_i-1)/l_max;
+    }
+
+    X k_ = P[k];
+    if (k_ == k) return;
+
+    interv_seq<T> I_(k_);
+    #pragma omp parallel for num_threads(p)
+    for (X i=0; i<k; i++) {
+        T p_i = I->at(i).first;
+        T q_i = I->at(i).second;
+
+        for (X t=0; t<P[i+1]-P[i]; t++) {
+            I_[P[i]+t] = interv_pair<T>{p_i+(T) t*l_max,q_i+(T) t*l_max};
+        }
+    }
+
+    if (pi_I != NULL) {
+        // the intervals, [p_i, p_i + d_i - 1] is split into, are consecutive in the order of the output intervals
+        std::vector<X> R(k+1);
+        R[0] = 0;
+        for (X r=0; r<k; r++) {
+            X i = pi_I->at(r);
+            R[r+1] = R[r] + (P[i+1]-P[i]);
+        }
+
+        std::vector<X> pi_(k_);
+        #pragma omp parallel for num_threads(p)
+        for (X r=0; r<k; r++) {
+            X i = pi_I->at(r);
+
+            for (X t=0; t<P[i+1]-P[i]; t++) {
+                pi_[R[r]+t] = P[i]+t;
+            }
+        }
+
+        pi_I->swap(pi_);
+    }
+
+    I->swap(I_);
+    k = k_;
+}
+
+template <typename T, typename X>
+void mdsb<T,X>::build_v2_v3_v4(interv_seq<T> *I, int v, bool log, std::ostream *os, std::vector<X> *pi_I) {
     size_t baseline;
     std::chrono::steady_clock::time_point time;
 
@@ -61,7 +130,7 @@ void mdsb<T>::build_v2_v3_v4(interv_seq<T> *I, int v, bool log, std::ostream *os
 
     if (log) log_memory_usage(baseline,"building L_in and T_out");
 
-    build_lin_tout(I);
+    build_lin_tout(I,pi_I);
     
     if (log) {
         if (os != NULL) {
@@ -119,13 +188,13 @@ void mdsb<T>::build_v2_v3_v4(interv_seq<T> *I, int v, bool log, std::ostream *os
     if (log) std::cout << std::endl << "peak memory allocation during build: ~ " << (malloc_count_peak()-baseline)/1000000 << "MB" << std::endl << std::endl;
 }
 
-template <typename T>
-void mdsb<T>::verify_correctness() {
+template <typename T, typename X>
+void mdsb<T,X>::verify_correctness() {
     std::cout << "verifying correctness of the interval sequence:" << std::endl;
     bool correct = true;
 
     #pragma omp parallel for num_threads(p)
-    for (T i=1; i<k; i++) {
+    for (X i=1; i<k; i++) {
         if (md->D_pair[i].first <= md->D_pair[i-1].first) {
             if (correct) {
                 correct = false;
@@ -138,19 +207,19 @@ void mdsb<T>::verify_correctness() {
     }
 
     #pragma omp parallel for num_threads(p)
-    for (T j=0; j<k; j++) {
-        T l = 0;
-        T r = k-1;
-        T m;
+    for (X j=0; j<k; j++) {
+        X l = 0;
+        X r = k-1;
+        X m;
         while (l != r) {
-            m = (l+r)/2;
+            m = l+(r-l)/2;
              if (md->D_pair[m].first >= md->D_pair[j].second) {
                 r = m;
             } else {
                 l = m+1;
             }
         }
-        T i = l;
+        X i = l;
 
         if (i+2*a-1 < k) {
             T q_j = md->D_pair[j].second;
@@ -2,8 +2,8 @@
 
 #include <mdsb.hpp>
 
-template <typename T>
-void mdsb<T>::build_v1(interv_seq<T> *I, bool log, std::ostream *os) {
+template <typename T, typename X>
+void mdsb<T,X>::build_v1(interv_seq<T> *I, bool log, std::ostream *os) {
     size_t baseline;
     std::chrono::steady_clock::time_point time;
 
@@ -57,7 +57,7 @@ void mdsb<T>::build_v1(interv_seq<T> *I, bool log, std::ostream *os) {
     T q_i,q_next;
     avl_node<std::pair<T,T>> *node_cur;
     T e;
-    for (T i=0; i<k; i++) {
+    for (X i=0; i<k; i++) {
         // For each output interval [q_i, q_i + d_i - 1], find the first input interval connected to it in the permutation graph.
         q_i = I->at(i).second;
         q_next = q_i + I->at(i+1).first - I->at(i).first;
@@ -152,7 +152,7 @@ void mdsb<T>::build_v1(interv_seq<T> *I, bool log, std::ostream *os) {
     // build D_pair
     md->D_pair.resize(k+1);
     auto it = T_in.iterator();
-    for (T i=0; i<=k; i++) {
+    for (X i=0; i<=k; i++) {
         md->D_pair[i] = it.current()->v;
         it.next();
     }
@@ -167,16 +167,17 @@ void mdsb<T>::build_v1(interv_seq<T> *I, bool log, std::ostream *os) {
         log_memory_usage(baseline,"building D_index");
     }
 
-    // build D_index
+    // build D_index; the fast_bit can only be used, if it is not needed to store k
     md->D_index.resize(k);
-    for (T j=0; j<k; j++) {
+    md->fast = (uint64_t) k < mds<T,X>::fast_bit;
+    for (X j=0; j<k; j++) {
         // For each output interval [q_j, q_j + d_j - 1], find the input interval [p_i, p_i + d_i - 1], q_j is in and set D_index[j] = i.
         // Find the maximum integer i \in [0,k-1], so that p_i <= q_j with a binary search over D_pair.
-        T l = 0;
-        T r = k-1;
-        T m;
+        X l = 0;
+        X r = k-1;
+        X m;
         while (l != r) {
-            m = (l+r)/2+1;
+            m = l+(r-l)/2+1;
             if (md->D_pair[m].first > md->D_pair[j].second) {
                 r = m-1;
             } else {
@@ -184,6 +185,13 @@ void mdsb<T>::build_v1(interv_seq<T> *I, bool log, std::ostream *os) {
             }
         }
         md->D_index[j] = l;
+
+        // If the output interval ends before p_{i+1}, move needs not scan for positions in [p_j, p_j + d_j - 1],
+        // which is marked by the fast_bit.
+        if (md->fast &&
+            md->D_pair[j].second+(md->D_pair[j+1].first-md->D_pair[j].first) <= md->D_pair[l+1].first) {
+            md->D_index[j] = (uint64_t) l | mds<T,X>::fast_bit;
+        }
     }
 
     if (log) {
@@ -1,7 +1,7 @@
 #include <mdsb.hpp>
 
-template <typename T>
-void mdsb<T>::balance_v2() {
+template <typename T, typename X>
+void mdsb<T,X>::balance_v2() {
     /* 
         contains pairs (pair_list_node<T> *p1, pair_list_node<T> *p2),
         where p2 is associated with an output interval with at least 2a incoming edges in the permutation graph
@@ -114,7 +114,7 @@ void mdsb<T>::balance_v2() {
                 T i__ = i_;
 
                 pln_ZpA = is_unbalanced(&pln_Z,&i_,ptn_Y);
-                if (pln_ZpA != NULL && i__ > a+1 && pln_Z->sc->v.first < q_y + interval_length_seq(&ptn_Y->v)) {
+                if (pln_ZpA != NULL && i__ > a+1 && pln_Z->sc != NULL && pln_Z->sc->v.first < q_y + interval_length_seq(&ptn_Y->v)) {
                     pln_ZpA = NULL;
                 }
             }
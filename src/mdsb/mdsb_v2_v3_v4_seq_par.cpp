@@ -2,8 +2,8 @@
 
 #include <mdsb.hpp>
 
-template <typename T>
-void mdsb<T>::build_lin_tout(interv_seq<T> *I) {
+template <typename T, typename X>
+void mdsb<T,X>::build_lin_tout(interv_seq<T> *I, std::vector<X> *pi_I) {
     L_in = std::vector<pair_list<T>>(p);
 
     T_out = std::vector<pair_tree<T>>(p,
@@ -20,29 +20,36 @@ void mdsb<T>::build_lin_tout(interv_seq<T> *I) {
     s[p] = n;
 
     // [0..p-1], u[i] stores the number of output intervals in I starting before s[i]
-    std::vector<T> u(p+1);
+    std::vector<X> u(p+1);
     u[0] = 0;
     u[p] = k;
 
     // [0..p-1], x[i] stores the number of input intervals in I starting before s[i]
-    std::vector<T> x(p+1);
+    std::vector<X> x(p+1);
     x[0] = 0;
     x[p] = k;
 
     {
-        // create identity permutation pi of [0..k-1]
-        std::vector<T> pi(k);
-        #pragma omp parallel for num_threads(p)
-        for (T i=0; i<k; i++) {
-            pi[i] = i;
-        }
+        std::vector<X> pi;
 
-        // sort pi by q
-        auto comp = [I](T i1, T i2){return I->at(i1).second < I->at(i2).second;};
-        if (p > 1) {
-            ips4o::parallel::sort(pi.begin(),pi.end(),comp);
+        if (pi_I != NULL) {
+            // pi_I already sorts I by q
+            pi.swap(*pi_I);
         } else {
-            ips4o::sort(pi.begin(),pi.end(),comp);
+            // create identity permutation pi of [0..k-1]
+            pi.resize(k);
+            #pragma omp parallel for num_threads(p)
+            for (X i=0; i<k; i++) {
+                pi[i] = i;
+            }
+
+            // sort pi by q
+            auto comp = [I](X i1, X i2){return I->at(i1).second < I->at(i2).second;};
+            if (p > 1) {
+                ips4o::parallel::sort(pi.begin(),pi.end(),comp);
+            } else {
+                ips4o::sort(pi.begin(),pi.end(),comp);
+            }
         }
 
         // calculate seperation positions
@@ -50,19 +57,20 @@ void mdsb<T>::build_lin_tout(interv_seq<T> *I) {
         {
             int i_p = omp_get_thread_num();
 
-            T o = i_p*((2*k)/p);
+            uint64_t o = i_p*((2*(uint64_t) k)/p);
 
-            T l_s,l_x,l_u,m_s,m_x,m_u,r_s,r_x,r_u;
+            T l_s,m_s,r_s;
+            X l_x,l_u,m_x,m_u,r_x,r_u;
 
             l_s = 0;
             r_s = n-1;
             do {
-                m_s = (l_s+r_s)/2;
+                m_s = l_s+(r_s-l_s)/2;
 
                 l_x = 0;
                 r_x = k-1;
                 while (l_x != r_x) {
-                    m_x = (l_x+r_x)/2;
+                    m_x = l_x+(r_x-l_x)/2;
                     if (I->at(m_x).first < m_s) {
                         l_x = m_x+1;
                     } else {
@@ -73,7 +81,7 @@ void mdsb<T>::build_lin_tout(interv_seq<T> *I) {
                 l_u = 0;
                 r_u = k-1;
                 while (l_u != r_u) {
-                    m_u = (l_u+r_u)/2;
+                    m_u = l_u+(r_u-l_u)/2;
                     if (I->at(pi[m_u]).second < m_s) {
                         l_u = m_u+1;
                     } else {
@@ -85,7 +93,7 @@ void mdsb<T>::build_lin_tout(interv_seq<T> *I) {
                     break;
                 }
 
-                if (l_x+l_u < o) {
+                if ((uint64_t) l_x+l_u < o) {
                     l_s = m_s + 1;
                 } else {
                     r_s = m_s;
@@ -99,22 +107,22 @@ void mdsb<T>::build_lin_tout(interv_seq<T> *I) {
 
         // stores the nodes to build L_in[0..p-1] and T_out[0..p-1] out of
         nodes = std::vector<std::vector<pair_tree_node<T>>*>(p);
-        T k_p = 1+(k-1)/p;
+        X k_p = 1+(k-1)/p;
         #pragma omp parallel num_threads(p)
         {
             int i_p = omp_get_thread_num();
 
-            T l = i_p*k_p;
-            T r = i_p == p-1 ? k : (i_p+1)*k_p;
+            X l = i_p*k_p;
+            X r = i_p == p-1 ? k : (i_p+1)*k_p;
 
             // allocate nodes
             nodes[i_p] = new std::vector<pair_tree_node<T>>(r-l);
 
             // insert pairs into nodes and build L_in[0..p-1]
-            T i_m = r-l;
-            T i_I = l;
+            X i_m = r-l;
+            X i_I = l;
             nodes[i_p]->at(0).v.v = I->at(i_p*k_p);
-            for (T i=1; i<i_m; i++) {
+            for (X i=1; i<i_m; i++) {
                 i_I++;
                 nodes[i_p]->at(i).v.v = I->at(i_I);
                 nodes[i_p]->at(i).v.pr = &nodes[i_p]->at(i-1).v;
@@ -129,7 +137,7 @@ void mdsb<T>::build_lin_tout(interv_seq<T> *I) {
             }
             L_in[i_p].set_size(x[i_p+1]-x[i_p]);
             if (!L_in[i_p].empty()) {
-                T i_n = x[i_p]/k_p;
+                X i_n = x[i_p]/k_p;
                 L_in[i_p].set_head(&nodes[i_n]->at(x[i_p]-i_n*k_p).v);
                 i_n = (x[i_p+1]-1)/k_p;
                 L_in[i_p].set_tail(&nodes[i_n]->at((x[i_p+1]-1)-i_n*k_p).v);
@@ -174,7 +182,7 @@ void mdsb<T>::build_lin_tout(interv_seq<T> *I) {
     for (int i=1; i<p; i++) {
         if (L_in[i].empty() || L_in[i].head()->v.first != s[i]) {
             pair_list_node<T> *pln = L_in[i-1].tail();
-            pair_tree_node<T> *ptn = new_nodes[i].emplace_back(pair_tree_node<T>(pair_list_node<T>(interv_pair<T>{s[i],pln->v.second+s[i]-pln->v.first})));
+            pair_tree_node<T> *ptn = new_nodes[i].emplace_back(pair_tree_node<T>(pair_list_node<T>(interv_pair<T>{s[i],pln->v.second+(s[i]-pln->v.first)})));
 
             // find i_ \in [0,p-1], so that s[i_] <= ptn->v.v.second < s[i_+1]
             int l = 0;
@@ -199,7 +207,7 @@ void mdsb<T>::build_lin_tout(interv_seq<T> *I) {
     for (int i=1; i<p; i++) {
         if (T_out[i].empty() || T_out[i].minimum()->v.v.second != s[i]) {
             pair_list_node<T> *pln = &T_out[i-1].maximum()->v;
-            pair_tree_node<T> *ptn = new_nodes[i].emplace_back(pair_tree_node<T>(pair_list_node<T>(interv_pair<T>{pln->v.first+s[i]-pln->v.second,s[i]})));
+            pair_tree_node<T> *ptn = new_nodes[i].emplace_back(pair_tree_node<T>(pair_list_node<T>(interv_pair<T>{pln->v.first+(s[i]-pln->v.second),s[i]})));
 
             // find i_ \in [0,p-1], so that s[i_] <= ptn->v.v.first < s[i_+1]
             int l = 0;
@@ -229,10 +237,10 @@ void mdsb<T>::build_lin_tout(interv_seq<T> *I) {
     }
 }
 
-template <typename T>
-void mdsb<T>::build_dpair() {
+template <typename T, typename X>
+void mdsb<T,X>::build_dpair() {
     // [0..p-1], x[i] stores the number of input intervals in I starting before s[i]
-    std::vector<T> x(p+1);
+    std::vector<X> x(p+1);
     x[0] = 0;
     for (int i=0; i<p; i++) {
         x[i+1] = x[i]+L_in[i].size();
@@ -250,15 +258,15 @@ void mdsb<T>::build_dpair() {
         {
             for (int i_p=0; i_p<p; i_p++) {
                 
-                T l = x[i_p];
-                T r = x[i_p+1]-1;
-                T m = (l+r)/2;
+                X l = x[i_p];
+                X r = x[i_p+1]-1;
+                X m = l+(r-l)/2;
 
                 #pragma omp task
                 {
                     typename pair_list<T>::dll_it it = L_in[i_p].iterator();
 
-                    for (T i=l; i<=m; i++) {
+                    for (X i=l; i<=m; i++) {
                         md->D_pair[i] = it.current()->v;
                         it.next();
                     }
@@ -267,7 +275,7 @@ void mdsb<T>::build_dpair() {
                 {
                     typename pair_list<T>::dll_it it = L_in[i_p].iterator(L_in[i_p].tail());
 
-                    for (T i=r; i>m; i--) {
+                    for (X i=r; i>m; i--) {
                         md->D_pair[i] = it.current()->v;
                         it.previous();
                     }
@@ -290,19 +298,21 @@ void mdsb<T>::build_dpair() {
     nodes.clear();
 }
 
-template <typename T>
-void mdsb<T>::build_dindex() {
+template <typename T, typename X>
+void mdsb<T,X>::build_dindex() {
+    // the fast_bit can only be used, if it is not needed to store k
     md->D_index.resize(k);
+    md->fast = (uint64_t) k < mds<T,X>::fast_bit;
 
     #pragma omp parallel for num_threads(p)
-    for (T j=0; j<k; j++) {
+    for (X j=0; j<k; j++) {
         // For each output interval [q_j, q_j + d_j - 1], find the input interval [p_i, p_i + d_i - 1], q_j is in and set D_index[j] = i.
         // Find the maximum integer i \in [0,k-1], so that p_i <= q_j with a binary search over D_pair.
-        T l = 0;
-        T r = k-1;
-        T m;
+        X l = 0;
+        X r = k-1;
+        X m;
         while (l != r) {
-            m = (l+r)/2+1;
+            m = l+(r-l)/2+1;
             if (md->D_pair[m].first > md->D_pair[j].second) {
                 r = m-1;
             } else {
@@ -310,18 +320,25 @@ void mdsb<T>::build_dindex() {
             }
         }
         md->D_index[j] = l;
+
+        // If the output interval ends before p_{i+1}, move needs not scan for positions in [p_j, p_j + d_j - 1],
+        // which is marked by the fast_bit.
+        if (md->fast &&
+            md->D_pair[j].second+(md->D_pair[j+1].first-md->D_pair[j].first) <= md->D_pair[l+1].first) {
+            md->D_index[j] = (uint64_t) l | mds<T,X>::fast_bit;
+        }
     }
 }
 
-template <typename T>
-T mdsb<T>::interval_length_seq(pair_list_node<T> *pln) {
+template <typename T, typename X>
+T mdsb<T,X>::interval_length_seq(pair_list_node<T> *pln) {
     return (pln->sc != NULL ? pln->sc->v.first : n) - pln->v.first;
 }
 
-template <typename T>
-pair_list_node<T>* mdsb<T>::is_unbalanced(pair_list_node<T> **pln_IpI_, T *i_, pair_tree_node<T> *ptn_J, pair_tree_node<T> *ptn_J_nxt) {
+template <typename T, typename X>
+pair_list_node<T>* mdsb<T,X>::is_unbalanced(pair_list_node<T> **pln_IpI_, T *i_, pair_tree_node<T> *ptn_J, pair_tree_node<T> *ptn_J_nxt) {
     // [l,r] = [q_j, q_j + d_j - 1]
-    T rp1 = ptn_J_nxt == NULL ? ptn_J->v.v.second + interval_length_seq(&ptn_J->v) : ptn_J_nxt->v.v.second;
+    T rp1 = ptn_J_nxt == NULL ? (T) (ptn_J->v.v.second + interval_length_seq(&ptn_J->v)) : ptn_J_nxt->v.v.second;
 
     // If |[l,r]| < 2a, there cannot be at least 2a input intervals connected to [l,r] in the permutation graph.
     if (rp1-ptn_J->v.v.second < 2*a) return NULL;
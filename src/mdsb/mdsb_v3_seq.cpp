@@ -1,7 +1,7 @@
 #include <mdsb.hpp>
 
-template <typename T>
-pair_tree_node<T>* mdsb<T>::balance_upto_seq(pair_list_node<T> *pln_IpA, pair_tree_node<T> *ptn_J, T q_u, T p_cur, T *i_) {
+template <typename T, typename X>
+pair_tree_node<T>* mdsb<T,X>::balance_upto_seq(pair_list_node<T> *pln_IpA, pair_tree_node<T> *ptn_J, T q_u, T p_cur, T *i_) {
     T p_j = ptn_J->v.v.first;
     T q_j = ptn_J->v.v.second;
     T d_j = interval_length_seq(&ptn_J->v);
@@ -56,8 +56,8 @@ pair_tree_node<T>* mdsb<T>::balance_upto_seq(pair_list_node<T> *pln_IpA, pair_tr
     return ptn_NEW;
 }
 
-template <typename T>
-void mdsb<T>::balance_v3_seq() {
+template <typename T, typename X>
+void mdsb<T,X>::balance_v3_seq() {
 
     // points to to the pair (p_i,q_i).
     pair_list_node<T> *pln_I = L_in[0].head();
@@ -1,7 +1,7 @@
 #include <mdsb.hpp>
 
-template <typename T>
-pair_tree_node<T>* mdsb<T>::balance_upto_v4_par(ins_matr_v4<T> &Q_ins, pair_list_node<T> *pln_IpA, pair_tree_node<T> *ptn_J, pair_tree_node<T>* ptn_J_nxt, T q_u, T p_cur, T *i_) {
+template <typename T, typename X>
+pair_tree_node<T>* mdsb<T,X>::balance_upto_v4_par(ins_matr_v4<T> &Q_ins, pair_list_node<T> *pln_IpA, pair_tree_node<T> *ptn_J, pair_tree_node<T>* ptn_J_nxt, T q_u, T p_cur, T *i_) {
     int i_p = omp_get_thread_num();
 
     T p_j = ptn_J->v.v.first;
@@ -64,8 +64,8 @@ pair_tree_node<T>* mdsb<T>::balance_upto_v4_par(ins_matr_v4<T> &Q_ins, pair_list
     return ptn_NEW;
 }
 
-template <typename T>
-void mdsb<T>::balance_v4_par() {
+template <typename T, typename X>
+void mdsb<T,X>::balance_v4_par() {
     /** @brief [0..p-1] stores queues with tuples (*p1,*p2);
      *        Q_ins[i] stores the tuples to insert into thread i's section [s[i]..s[i+1] */
     ins_matr_v4<T> Q_ins(p);
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <bit>
+#include <functional>
+#include <iostream>
+#include <immintrin.h>
+
+#include <ef_vector.hpp>
+
+template <typename T>
+ef_vector<T>::ef_vector() {
+    m = 0;
+    u = 0;
+    l = 0;
+}
+
+template <typename T>
+ef_vector<T>::ef_vector(uint64_t m, T u, std::function<T(uint64_t)> at) {
+    this->m = m;
+    this->u = u;
+    l = m > 0 && (uint64_t) u/m >= 2 ? std::bit_width((uint64_t) u/m)-1 : 0;
+
+    L = packed_vector<T>(m,l);
+    H.resize((m+((uint64_t) u >> l)+1+63)/64+1,0);
+    // an empty sequence has no samples
+    S.resize(m == 0 ? 0 : ((m-1) >> s_sel)+1);
+
+    uint64_t pos;
+    for (uint64_t i=0; i<m; i++) {
+        T v = at(i);
+        L.set(i,v);
+        pos = ((uint64_t) v >> l)+i;
+        H[pos >> 6] |= (uint64_t) 1 << (pos & 63);
+
+        if ((i & ((1 << s_sel)-1)) == 0) {
+            S[i >> s_sel] = pos;
+        }
+    }
+}
+
+template <typename T>
+ef_vector<T>::~ef_vector() {}
+
+template <typename T>
+ef_vector<T>::ef_vector(std::istream &in) {
+    in.read((char*)&m,sizeof(uint64_t));
+    in.read((char*)&u,sizeof(T));
+    in.read((char*)&l,sizeof(uint8_t));
+
+    L = packed_vector<T>(in);
+
+    H.resize((m+((uint64_t) u >> l)+1+63)/64+1);
+    in.read((char*)&H[0],H.size()*sizeof(uint64_t));
+
+    // an empty sequence has no samples
+    S.resize(m == 0 ? 0 : ((m-1) >> s_sel)+1);
+    in.read((char*)S.data(),S.size()*sizeof(uint64_t));
+}
+
+template <typename T>
+uint64_t ef_vector<T>::serialize(std::ostream &out) const {
+    out.write((char*)&m,sizeof(uint64_t));
+    out.write((char*)&u,sizeof(T));
+    out.write((char*)&l,sizeof(uint8_t));
+
+    uint64_t size = sizeof(uint64_t)+sizeof(T)+sizeof(uint8_t)+L.serialize(out);
+
+    out.write((char*)&H[0],H.size()*sizeof(uint64_t));
+    out.write((char*)S.data(),S.size()*sizeof(uint64_t));
+
+    return size+(H.size()+S.size())*sizeof(uint64_t);
+}
+
+template <typename T>
+uint64_t ef_vector<T>::size() const {
+    return m;
+}
+
+template <typename T>
+uint64_t ef_vector<T>::select(uint64_t i) const {
+    uint64_t pos = S[i >> s_sel];
+    uint64_t r = i & ((1 << s_sel)-1);
+
+    if (r == 0) {
+        return pos;
+    }
+
+    // skip the words before the one containing the r-th one after pos
+    uint64_t j = pos >> 6;
+    uint64_t w = H[j] & (~(uint64_t)1 << (pos & 63));
+    uint64_t c;
+    while ((c = std::popcount(w)) < r) {
+        r -= c;
+        w = H[++j];
+    }
+
+    // select the r-th one in w
+    #if defined(__BMI2__)
+    return (j << 6)+_tzcnt_u64(_pdep_u64((uint64_t)1 << (r-1),w));
+    #else
+    for (uint64_t t=1; t<r; t++) {
+        w &= w-1;
+    }
+    return (j << 6)+std::countr_zero(w);
+    #endif
+}
+
+template <typename T>
+T ef_vector<T>::operator[](uint64_t i) const {
+    return (T) ((select(i)-i) << l) | L[i];
+}
+
+template <typename T>
+typename ef_vector<T>::ef_it ef_vector<T>::iterator(uint64_t i) const {
+    return ef_it(this,i);
+}
+
+template <typename T>
+ef_vector<T>::ef_it::ef_it(const ef_vector<T> *v, uint64_t i) {
+    this->v = v;
+    this->i = i;
+    pos = v->select(i);
+}
+
+template <typename T>
+T ef_vector<T>::ef_it::current() const {
+    return (T) ((pos-i) << v->l) | v->L[i];
+}
+
+template <typename T>
+T ef_vector<T>::ef_it::next() {
+    i++;
+    pos++;
+
+    // find the next one in H at or after pos
+    uint64_t w = v->H[pos >> 6] >> (pos & 63);
+    while (w == 0) {
+        pos = (pos | 63)+1;
+        w = v->H[pos >> 6];
+    }
+    pos += std::countr_zero(w);
+
+    return current();
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <bit>
+#include <iostream>
+
+#include <packed_vector.hpp>
+
+template <typename T>
+packed_vector<T>::packed_vector() {
+    m = 0;
+    w = 1;
+    mask = 1;
+}
+
+template <typename T>
+packed_vector<T>::packed_vector(uint64_t m, uint8_t w) {
+    this->m = m;
+    this->w = w;
+    mask = w == 64 ? ~(uint64_t)0 : ((uint64_t)1 << w)-1;
+    data.resize(std::max<uint64_t>((m*w+63)/64,1)+1,0);
+}
+
+template <typename T>
+packed_vector<T>::~packed_vector() {}
+
+template <typename T>
+packed_vector<T>::packed_vector(std::istream &in) {
+    in.read((char*)&m,sizeof(uint64_t));
+    in.read((char*)&w,sizeof(uint8_t));
+    mask = w == 64 ? ~(uint64_t)0 : ((uint64_t)1 << w)-1;
+
+    data.resize(std::max<uint64_t>((m*w+63)/64,1)+1,0);
+    in.read((char*)&data[0],data.size()*sizeof(uint64_t));
+}
+
+template <typename T>
+uint64_t packed_vector<T>::serialize(std::ostream &out) const {
+    out.write((char*)&m,sizeof(uint64_t));
+    out.write((char*)&w,sizeof(uint8_t));
+    out.write((char*)&data[0],data.size()*sizeof(uint64_t));
+
+    return sizeof(uint64_t)+sizeof(uint8_t)+data.size()*sizeof(uint64_t);
+}
+
+template <typename T>
+uint64_t packed_vector<T>::size() const {
+    return m;
+}
+
+template <typename T>
+uint8_t packed_vector<T>::width() const {
+    return w;
+}
+
+template <typename T>
+uint8_t packed_vector<T>::width_of(uint64_t v) {
+    return std::max<uint8_t>(1,std::bit_width(v));
+}
+
+template <typename T>
+T packed_vector<T>::get(uint64_t i) const {
+    uint64_t b = i*w;
+    uint64_t j = b >> 6;
+    uint8_t o = b & 63;
+
+    // (data[j+1] << 1) << (63-o) avoids shifting by 64 if o = 0
+    return (T) (((data[j] >> o) | ((data[j+1] << 1) << (63-o))) & mask);
+}
+
+template <typename T>
+T packed_vector<T>::operator[](uint64_t i) const {
+    return get(i);
+}
+
+template <typename T>
+void packed_vector<T>::set(uint64_t i, T v) {
+    uint64_t b = i*w;
+    uint64_t j = b >> 6;
+    uint8_t o = b & 63;
+    uint64_t v_ = (uint64_t) v & mask;
+
+    data[j] = (data[j] & ~(mask << o)) | (v_ << o);
+
+    if (o+w > 64) {
+        data[j+1] = (data[j+1] & ~(mask >> (64-o))) | (v_ >> (64-o));
+    }
+}
\ No newline at end of file
@@ -42,7 +42,8 @@ std::string to_string_with_precision(const T a_value, const int n = 6)
 }
 
 void log_invalid_input() {
-    std::cout << "invalid input, usage: a p v t (m)" << std::endl;
+    std::cout << "invalid input, usage: (-x) a p v t (m)" << std::endl;
+    std::cout << "    -x: (optional) additionally benchmarks the linear and the exponential scan and builds M_LF^{-1}" << std::endl;
     std::cout << "    a: balancing parameter, restricts size increase to the factor (1+1/(a-1))" << std::endl;
     std::cout << "    p: number of threads to use (1 for v=1/2, 1<=p<=n for v=3, 2<=p<=n for v=4)" << std::endl;
     std::cout << "    v: build method version (1/2/3/4)" << std::endl;
@@ -51,15 +52,33 @@ void log_invalid_input() {
 }
 
 template<typename INT_T>
-void test(std::string &T, INT_T n, int a, int p, int v, std::chrono::steady_clock::time_point time, std::string text_file_name, std::ofstream *measurement_file = NULL) {
-    std::vector<INT_T>SA(n);
+void test(std::string &T, INT_T n, int a, int p, int v, bool extended, std::chrono::steady_clock::time_point time, std::string text_file_name, std::ofstream *measurement_file = NULL) {
+    // SA is allocated with malloc, so that the buffer of the uint32_t path can be shrunk with realloc
+    INT_T *SA;
     if (std::is_same<INT_T,int32_t>::value) {
+        SA = (INT_T*) malloc(n*sizeof(INT_T));
         if (p > 1) {
             libsais_omp((uint8_t*)&T[0],(int32_t*)&SA[0],(int32_t)n,0,NULL,p);
         } else {
             libsais((uint8_t*)&T[0],(int32_t*)&SA[0],(int32_t)n,0,NULL);
         }
+    } else if (std::is_same<INT_T,uint32_t>::value) {
+        // libsais has no unsigned 32-bit interface, so the suffix array is built with libsais64 and then narrowed
+        // in place, which needs 8n instead of 12n bytes; SA[i] is written to the bytes [4i,4i+3] of SA_64, which
+        // only overlap SA_64[i/2], that has already been read, so the narrowing runs sequentially
+        int64_t *SA_64 = (int64_t*) malloc(n*sizeof(int64_t));
+        if (p > 1) {
+            libsais64_omp((uint8_t*)&T[0],SA_64,(int64_t)n,0,NULL,p);
+        } else {
+            libsais64((uint8_t*)&T[0],SA_64,(int64_t)n,0,NULL);
+        }
+        for (INT_T i=0; i<n; i++) {
+            INT_T s = SA_64[i];
+            std::memcpy((char*)SA_64+i*sizeof(INT_T),&s,sizeof(INT_T));
+        }
+        SA = (INT_T*) realloc(SA_64,n*sizeof(INT_T));
     } else {
+        SA = (INT_T*) malloc(n*sizeof(INT_T));
         if (p > 1) {
             libsais64_omp((uint8_t*)&T[0],(int64_t*)&SA[0],(int64_t)n,0,NULL,p);
         } else {
@@ -100,7 +119,7 @@ void test(std::string &T, INT_T n, int a, int p, int v, std::chrono::steady_cloc
             std::vector<INT_T> C_(256,0);
             INT_T l = 0;
             uint8_t c = bwt[0];
-            I_LF->emplace_back(std::make_pair(0,C[c]));
+            I_LF->emplace_back(std::make_pair((INT_T) 0,C[c]));
             for (INT_T i=1; i<n; i++) {
                 if (bwt[i] != c) {
                     C_[c] += i-l;
@@ -129,6 +148,38 @@ void test(std::string &T, INT_T n, int a, int p, int v, std::chrono::steady_cloc
         r_ = M_LF.intervals();
     }
 
+    if (extended) {
+        // benchmark the linear and the exponential scan in move by walking the LF-chain
+        INT_T steps = std::min<INT_T>(n,100000000);
+        std::pair<INT_T,INT_T> ix;
+
+        for (INT_T t_exp : {(INT_T) 0,(INT_T) 4}) {
+            M_LF.set_exp_scan(t_exp);
+            std::chrono::steady_clock::time_point time_scan = std::chrono::steady_clock::now();
+            ix = M_LF.walk(std::make_pair((INT_T) 0,(INT_T) 0),steps);
+            std::string scan_type = t_exp == 0 ? "linear" : "exponential";
+
+            if (measurement_file != NULL) {
+                *measurement_file << "RESULT text=" << text_file_name << " type=scan_" << scan_type << " a=" << a << " steps=" << steps << " time=" << time_diff(time_scan) << std::endl;
+            }
+            time = log_runtime(time,std::to_string(steps) + " LF-steps with the " + scan_type + " scan (" + std::to_string(ix.first) + ") calculated");
+        }
+
+        M_LF.set_exp_scan(0);
+    }
+
+    if (extended) {
+        // build the move datastructure of LF^{-1} from M_LF
+        std::chrono::steady_clock::time_point time_inv = std::chrono::steady_clock::now();
+        mds<INT_T> M_LF_inv = M_LF.inverse(a,p,v);
+        std::string growth_factor = to_string_with_precision(std::ceil(M_LF_inv.intervals()/(double) r_ * 1000.0)/1000.0,3);
+
+        if (measurement_file != NULL) {
+            *measurement_file << "RESULT text=" << text_file_name << " type=M_LF_inv" << " a=" << a << " p=" << p << " v=" << v << " time_tot=" << time_diff(time_inv) << " growth_factor=" << growth_factor << std::endl;
+        }
+        time = log_runtime(time,"M_LF^{-1} (r'_inv/r' = " + growth_factor + ") calculated");
+    }
+
     {
         std::vector<std::pair<INT_T,INT_T>> *I_phi = new std::vector<std::pair<INT_T,INT_T>>(r_);
         I_phi->at(0) = std::make_pair(SA[0],SA[n-1]);
@@ -156,23 +207,29 @@ void test(std::string &T, INT_T n, int a, int p, int v, std::chrono::steady_cloc
         }
         time = log_runtime(time,"M_phi (r''/r' = " + growth_factor_1 + ", r''/r = " + growth_factor_2 + ") calculated in");
     }
+
+    free(SA);
 }
 
 int main(int argc, char *argv[]) {
-    if (argc < 5 || 6 < argc) {
+    bool extended = argc > 1 && std::string(argv[1]) == "-x";
+    // offset of the positional arguments
+    int o = extended ? 1 : 0;
+
+    if (argc < 5+o || 6+o < argc) {
         log_invalid_input();
         return -1;
     }
 
-    int a = atoi(argv[1]);
-    int p = atoi(argv[2]);
-    int v = atoi(argv[3]);
-    std::string text_file_name = argv[4];
-    bool measure = argc == 6;
+    int a = atoi(argv[1+o]);
+    int p = atoi(argv[2+o]);
+    int v = atoi(argv[3+o]);
+    std::string text_file_name = argv[4+o];
+    bool measure = argc == 6+o;
     std::ofstream measurement_file;
 
     if (measure) {
-        measurement_file.open(argv[5],std::filesystem::exists(argv[5]) ? std::ios::app : std::ios::out);
+        measurement_file.open(argv[5+o],std::filesystem::exists(argv[5+o]) ? std::ios::app : std::ios::out);
     }
 
     if (!(
@@ -215,10 +272,14 @@ int main(int argc, char *argv[]) {
     T[n-1] = 1;
     time = log_runtime(time,"file read");
 
+    // texts, that are too long for int32_t, but shorter than 2^32 - 1, use unsigned 32-bit positions, which
+    // halves the memory of all arrays compared to int64_t
     if (n <= INT_MAX) {
-        test<int32_t>(T,n,a,p,v,time,text_file_name,(measure ? &measurement_file : NULL));
+        test<int32_t>(T,n,a,p,v,extended,time,text_file_name,(measure ? &measurement_file : NULL));
+    } else if (n < (int64_t) std::numeric_limits<uint32_t>::max()) {
+        test<uint32_t>(T,n,a,p,v,extended,time,text_file_name,(measure ? &measurement_file : NULL));
     } else {
-        test<int64_t>(T,n,a,p,v,time,text_file_name,(measure ? &measurement_file : NULL));
+        test<int64_t>(T,n,a,p,v,extended,time,text_file_name,(measure ? &measurement_file : NULL));
     }
 
     if (measure) {
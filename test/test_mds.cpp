@@ -0,0 +1,861 @@
+#include <iostream>
+#include <cstdint>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <limits>
+#include <set>
+#include <random>
+#include <sstream>
+#include <iterator>
+#include <fstream>
+#include <filesystem>
+#include <omp.h>
+
+extern "C" {
+    #include <malloc_count.h>
+}
+
+#include <mds.hpp>
+#include <mds.cpp>
+
+#include <mds_fused.hpp>
+#include <mds_fused.cpp>
+
+#include <mds_simd.hpp>
+#include <mds_simd.cpp>
+
+#include <mds_fixed.hpp>
+#include <mds_fixed.cpp>
+
+#include <mds_cl.hpp>
+#include <mds_cl.cpp>
+
+#include <mds_view.hpp>
+#include <mds_view.cpp>
+
+#include <mds_mmap.hpp>
+#include <mds_mmap.cpp>
+
+#include <mds_blocked.hpp>
+#include <mds_blocked.cpp>
+
+#include <mds_packed.hpp>
+#include <mds_packed.cpp>
+
+#include <mds_offset.hpp>
+#include <mds_offset.cpp>
+
+#include <mds_ef.hpp>
+#include <mds_ef.cpp>
+
+#include <mds_exec.hpp>
+#include <mds_exec.cpp>
+
+#include <mds_sched.hpp>
+#include <mds_sched.cpp>
+
+// instantiates all members for 40-bit positions, including those, that the tests do not call
+template class mds<uint40_t,uint32_t>;
+template class mds_view<uint40_t,uint32_t>;
+template class mds_exec<uint40_t,uint32_t>;
+template class mds_sched<uint40_t,uint32_t>;
+
+uint64_t failures = 0;
+
+void check(bool condition, std::string message) {
+    if (!condition) {
+        failures++;
+        std::cout << "check failed: " << message << std::endl;
+    }
+}
+
+/**
+ * @brief random disjoint interval sequence I of a bijective function f_I : [0..n-1] -> [0..n-1]
+ * @tparam T (integer) type of the interval starting positions
+ */
+template <typename T>
+struct test_instance {
+    uint64_t n; // maximum value
+    std::vector<std::pair<T,T>> I; // pairs (p_i,q_i) in ascending order of p_i
+
+    /**
+     * @brief creates a random disjoint interval sequence of k intervals over [0..n-1], whose output
+     *        intervals are a random permutation of the input intervals
+     * @param n maximum value
+     * @param k number of intervals, 1 <= k <= n/2
+     * @param g random generator
+     */
+    test_instance(uint64_t n, uint64_t k, std::mt19937_64 &g) {
+        this->n = n;
+
+        std::set<uint64_t> cuts{0};
+        while (cuts.size() < k) {
+            cuts.insert(1+g()%(n-1));
+        }
+        std::vector<uint64_t> p(cuts.begin(),cuts.end());
+
+        std::vector<uint64_t> pi(k);
+        for (uint64_t i=0; i<k; i++) {
+            pi[i] = i;
+        }
+        std::shuffle(pi.begin(),pi.end(),g);
+
+        std::vector<uint64_t> q(k);
+        uint64_t q_cur = 0;
+        for (uint64_t r=0; r<k; r++) {
+            uint64_t i = pi[r];
+            q[i] = q_cur;
+            q_cur += (i == k-1 ? n : p[i+1])-p[i];
+        }
+
+        for (uint64_t i=0; i<k; i++) {
+            I.emplace_back((T) p[i],(T) q[i]);
+        }
+    }
+
+    /**
+     * @brief calculates f_I(i) by a binary search over I
+     * @param i in [0..n-1]
+     * @return f_I(i)
+     */
+    uint64_t f(uint64_t i) const {
+        uint64_t x = std::upper_bound(I.begin(),I.end(),i,[](uint64_t i_, auto pr){return i_ < (uint64_t) pr.first;})-I.begin()-1;
+        return (uint64_t) I[x].second+(i-(uint64_t) I[x].first);
+    }
+
+    /**
+     * @brief builds the move datastructure of f_I
+     * @tparam X (integer) type of the interval indices
+     * @param a balancing parameter
+     * @param p number of threads
+     * @param v build method version
+     * @return move datastructure of f_I
+     */
+    template <typename X = T>
+    mds<T,X> build(T a, int p, int v) const {
+        std::vector<std::pair<T,T>> *I_ = new std::vector<std::pair<T,T>>(I);
+        mds<T,X> M(I_,(T) n,a,p,v);
+        // the build methods 2/3/4 delete I_, build method 1 does not
+        if (v == 1) delete I_;
+        return M;
+    }
+};
+
+/**
+ * @brief returns random positions in [0..n-1], that include 0 and n-1
+ * @param n maximum value
+ * @param m number of positions
+ * @param g random generator
+ * @return positions
+ */
+std::vector<uint64_t> random_positions(uint64_t n, uint64_t m, std::mt19937_64 &g) {
+    std::vector<uint64_t> pos{0,n-1};
+    while (pos.size() < m) {
+        pos.emplace_back(g()%n);
+    }
+    return pos;
+}
+
+/**
+ * @brief checks move, pair and index of M against f_I and the serialization round trip of M
+ */
+template <typename T, typename X>
+void test_mds(const test_instance<T> &inst, const mds<T,X> &M, T a, std::string name, std::mt19937_64 &g) {
+    X k = M.intervals();
+
+    for (X j=0; j<k; j++) {
+        // D_index[j] is the input interval containing q_j and the output interval [q_j, q_j + d_j - 1]
+        // overlaps at most 2a input intervals
+        X x = M.index(j);
+        T q_j = M.pair(j).second;
+        T e_j = q_j+(M.pair(j+1).first-M.pair(j).first);
+        check(M.pair(x).first <= q_j && q_j < M.pair(x+1).first,name+": D_index");
+        check(x+2*a >= k || M.pair(x+2*a).first >= e_j,name+": unbalanced output interval");
+    }
+
+    std::stringstream ss;
+    M.serialize(ss);
+    mds<T,X> M2(ss);
+
+    for (uint64_t i : random_positions(inst.n,2000,g)) {
+        std::pair<T,X> ix{(T) i,M.locate_interval((T) i)};
+        std::pair<T,X> ix2 = ix;
+        check(M.pair(ix.second).first <= (T) i && (T) i < M.pair(ix.second+1).first,name+": locate_interval");
+        M.move(ix);
+        M2.move(ix2);
+        check((uint64_t) ix.first == inst.f(i),name+": move");
+        check(M.pair(ix.second).first <= ix.first && ix.first < M.pair(ix.second+1).first,name+": move interval");
+        check(ix == ix2,name+": serialize");
+    }
+}
+
+/**
+ * @brief checks, that move_range of M returns the maximal contiguous runs of the image of [l,r]
+ */
+template <typename T>
+void test_move_range(const test_instance<T> &inst, const mds<T> &M, std::string name, std::mt19937_64 &g) {
+    for (int it=0; it<200; it++) {
+        uint64_t l = g()%inst.n;
+        uint64_t r = std::min<uint64_t>(inst.n-1,l+g()%3000);
+
+        // runs (i',d) of the image of [l,r], that are maximal, so that f_I(i+1) = f_I(i)+1 inside a run
+        std::vector<std::pair<uint64_t,uint64_t>> runs;
+        for (uint64_t i=l; i<=r; i++) {
+            uint64_t f_i = inst.f(i);
+            if (!runs.empty() && f_i == runs.back().first+runs.back().second) {
+                runs.back().second++;
+            } else {
+                runs.emplace_back(f_i,1);
+            }
+        }
+
+        std::vector<std::tuple<T,T,T>> out;
+        M.move_range((T) l,(T) r,M.locate_interval((T) l),out);
+        check(out.size() == runs.size(),name+": move_range runs");
+
+        for (uint64_t j=0; j<std::min<uint64_t>(out.size(),runs.size()); j++) {
+            auto [i_,d,x_] = out[j];
+            check((uint64_t) i_ == runs[j].first && (uint64_t) d == runs[j].second,name+": move_range");
+            check(M.pair(x_).first <= i_ && i_ < M.pair(x_+1).first,name+": move_range interval");
+            if (j > 0) check(std::get<0>(out[j-1])+std::get<1>(out[j-1]) != i_,name+": move_range contiguous");
+        }
+    }
+}
+
+/**
+ * @brief checks, that move on V agrees with move on M
+ * @tparam V move datastructure type with move(std::pair<T,T>&)
+ */
+template <typename T, typename V>
+void test_move(const test_instance<T> &inst, const mds<T> &M, const V &M_V, std::string name, std::mt19937_64 &g) {
+    for (uint64_t i : random_positions(inst.n,2000,g)) {
+        std::pair<T,T> ix{(T) i,M.locate_interval((T) i)};
+        std::pair<T,T> ix_v = ix;
+        M.move(ix);
+        M_V.move(ix_v);
+        check(ix == ix_v,name+": move");
+    }
+}
+
+template <typename T>
+void test_fused(const test_instance<T> &inst, const mds<T> &M, std::string name, std::mt19937_64 &g) {
+    name += " fused";
+    mds_fused<T> M_F(M);
+    std::stringstream ss;
+    M_F.serialize(ss);
+    mds_fused<T> M_F2(ss);
+
+    for (T x=0; x<M.intervals(); x++) {
+        const typename mds_fused<T>::interv_rec &rec = M_F2.record(x);
+        check(rec.p == M.pair(x).first && rec.q == M.pair(x).second && rec.idx == M.index(x),name+": record");
+    }
+    test_move(inst,M,M_F,name,g);
+    test_move(inst,M,M_F2,name+" serialize",g);
+}
+
+template <typename T>
+void test_simd(const test_instance<T> &inst, const mds<T> &M, std::string name, std::mt19937_64 &g) {
+    name += " simd";
+    mds_simd<T> M_S(M);
+    std::stringstream ss;
+    M_S.serialize(ss);
+    mds_simd<T> M_S2(ss);
+
+    check(M_S2.intervals() == M.intervals() && M_S2.max_value() == M.max_value(),name+": size");
+    test_move(inst,M,M_S,name,g);
+    test_move(inst,M,M_S2,name+" serialize",g);
+}
+
+/**
+ * @brief builds a compressed move datastructure out of M and checks pair, index, move and the serialization
+ *        round trip against M
+ * @tparam V move datastructure type with a constructor from mds<T> and from std::istream, pair(x), index(x),
+ *           move(std::pair<T,T>&) and serialize
+ */
+template <typename V, typename T>
+void test_compressed(const test_instance<T> &inst, const mds<T> &M, std::string name, std::mt19937_64 &g) {
+    V M_B(M);
+    std::stringstream ss;
+    M_B.serialize(ss);
+    V M_B2(ss);
+
+    check(M_B2.intervals() == M.intervals() && M_B2.max_value() == M.max_value(),name+": size");
+    for (T x=0; x<M.intervals(); x++) {
+        check(M_B.pair(x) == M.pair(x) && M_B.index(x) == M.index(x),name+": entry");
+        check(M_B2.pair(x) == M.pair(x) && M_B2.index(x) == M.index(x),name+": serialize entry");
+    }
+    test_move(inst,M,M_B,name,g);
+    test_move(inst,M,M_B2,name+" serialize",g);
+}
+
+/**
+ * @brief checks ef_vector access and the serialization round trip, including the empty sequence
+ */
+template <typename T>
+void test_ef_vector(std::mt19937_64 &g) {
+    for (uint64_t m : {(uint64_t) 0,(uint64_t) 1,(uint64_t) 1000}) {
+        std::string name = "ef_vector m=" + std::to_string(m);
+        std::vector<T> v(m);
+        for (uint64_t i=0; i<m; i++) v[i] = g() % 100000;
+        std::sort(v.begin(),v.end());
+        ef_vector<T> E(m,m == 0 ? 0 : v[m-1],[&v](uint64_t i){return v[i];});
+        std::stringstream ss;
+        E.serialize(ss);
+        ef_vector<T> E2(ss);
+
+        check(E.size() == m && E2.size() == m,name+": size");
+        for (uint64_t i=0; i<m; i++) {
+            check(E[i] == v[i] && E2[i] == v[i],name+": access");
+        }
+    }
+}
+
+/**
+ * @brief builds mds_fixed with the balancing parameter A and checks its move queries against f_I
+ */
+template <typename T, uint64_t A>
+void test_fixed(const test_instance<T> &inst, int p, int v, std::string name, std::mt19937_64 &g) {
+    name += " fixed";
+    std::vector<std::pair<T,T>> *I = new std::vector<std::pair<T,T>>(inst.I);
+    mds_fixed<T,A> M_A(I,(T) inst.n,p,v);
+    if (v == 1) delete I;
+    std::stringstream ss;
+    M_A.serialize(ss);
+    mds_fixed<T,A> M_A2(ss);
+
+    // the parallel build method may balance differently, so M_A is checked against f_I and M_A2 against M_A
+    for (uint64_t i : random_positions(inst.n,2000,g)) {
+        std::pair<T,T> ix{(T) i,M_A.locate_interval((T) i)};
+        std::pair<T,T> ix2 = ix;
+        M_A.move(ix);
+        M_A2.move(ix2);
+        check((uint64_t) ix.first == inst.f(i),name+": move");
+        check(M_A.pair(ix.second).first <= ix.first && ix.first < M_A.pair(ix.second+1).first,name+": move interval");
+        check(ix == ix2,name+": serialize");
+    }
+}
+
+/**
+ * @brief lays M out in cache line sized blocks and checks move and the serialization round trip
+ */
+template <typename T>
+void test_cl(const test_instance<T> &inst, const mds<T> &M, std::string name, std::mt19937_64 &g) {
+    name += " cl";
+    mds_cl<T> M_C(M);
+    std::stringstream ss;
+    M_C.serialize(ss);
+    mds_cl<T> M_C2(ss);
+
+    check(M_C.intervals() == M.intervals() && M_C.slots() % mds_cl<T>::B == 0,name+": slots");
+    check(M_C2.slots() == M_C.slots() && M_C2.max_value() == M.max_value(),name+": serialize size");
+
+    for (uint64_t i : random_positions(inst.n,2000,g)) {
+        std::pair<T,T> ix{(T) i,M_C.locate_slot((T) i)};
+        std::pair<T,T> ix2 = ix;
+        check(M_C.pair(ix.second).first <= (T) i && (T) i < M_C.pair(ix.second+1).first,name+": locate_slot");
+        M_C.move(ix);
+        M_C2.move(ix2);
+        check((uint64_t) ix.first == inst.f(i),name+": move");
+        check(M_C.pair(ix.second).first <= ix.first && ix.first < M_C.pair(ix.second+1).first,name+": move slot");
+        check(ix == ix2,name+": serialize");
+    }
+}
+
+/**
+ * @brief checks, that locate_interval, move and move_run of the view M_V agree with M, and walk, walk with an
+ *        output iterator or a callable and the batched move of M and M_V against single move queries and f_I
+ * @tparam V mds_view<T,X> or a class derived from it
+ */
+template <typename T, typename X, typename V>
+void test_move_view(const test_instance<T> &inst, const mds<T,X> &M, const V &M_V, std::string name, std::mt19937_64 &g) {
+    std::vector<std::pair<T,X>> ix_b;
+    std::vector<std::pair<T,X>> ix_1;
+    for (uint64_t i : random_positions(inst.n,2000,g)) {
+        X x = M_V.locate_interval((T) i);
+        check(x == M.locate_interval((T) i),name+": locate_interval");
+
+        std::pair<T,X> ix{(T) i,x};
+        std::pair<T,X> ix_v = ix;
+        std::pair<T,X> ix_r = ix;
+        M.move(ix);
+        M_V.move(ix_v);
+        T l = M_V.move_run(ix_r);
+        check(ix == ix_v && ix == ix_r,name+": move");
+        check(0 < l && l <= M.pair(x+1).first-(T) i,name+": move_run");
+
+        // the positions i+t, t in [0..l-1], all lie in the input interval x and move to (i'+t,x'), which
+        // is checked for a prefix and the last position, and i+l leaves the input or the output interval
+        for (T t=0; t<l; t = t+1 < std::min<T>(l,64) ? (T) (t+1) : std::max<T>(t+1,l-1)) {
+            std::pair<T,X> ix_t{(T) i+t,x};
+            M.move(ix_t);
+            check(ix_t.first == ix.first+t && ix_t.second == ix.second,name+": move_run step");
+        }
+        if ((uint64_t) i+l < inst.n) {
+            std::pair<T,X> ix_l{(T) i+l,M.locate_interval((T) i+l)};
+            X x_l = ix_l.second;
+            M.move(ix_l);
+            check(x_l != x || ix_l.first != ix.first+l || ix_l.second != ix.second,name+": move_run end");
+        }
+
+        // the pairs and positions visited by 5 single move queries
+        std::vector<std::pair<T,X>> ix_s{{(T) i,x}};
+        std::vector<T> i_s{(T) i};
+        for (int s=0; s<5; s++) {
+            std::pair<T,X> ix_n = ix_s.back();
+            M.move(ix_n);
+            ix_s.emplace_back(ix_n);
+            i_s.emplace_back((T) inst.f(i_s.back()));
+        }
+        check(ix_s[1] == ix && ix_s.back().first == i_s.back(),name+": single move queries");
+        check(M.walk(ix_s[0],5) == ix_s.back() && M_V.walk(ix_s[0],5) == ix_s.back(),name+": walk");
+        check(M_V.walk(ix_s[0],0) == ix_s[0],name+": walk without steps");
+
+        std::vector<T> i_o;
+        std::vector<T> i_v;
+        check(M.walk(ix_s[0],5,std::back_inserter(i_o)) == ix_s.back(),name+": walk with output iterator");
+        check(M_V.walk(ix_s[0],5,std::back_inserter(i_v)) == ix_s.back(),name+": walk with output iterator");
+        check(i_o == i_s && i_v == i_s,name+": walk output");
+
+        std::vector<std::pair<T,X>> ix_wo;
+        std::vector<std::pair<T,X>> ix_wv;
+        M.walk(ix_s[0],5,[&ix_wo](T i_,X x_){ix_wo.emplace_back(i_,x_);});
+        M_V.walk(ix_s[0],5,[&ix_wv](T i_,X x_){ix_wv.emplace_back(i_,x_);});
+        check(ix_wo == ix_s && ix_wv == ix_s,name+": walk with callable");
+
+        ix_b.emplace_back((T) i,x);
+        ix_1.emplace_back(ix);
+    }
+
+    std::vector<std::pair<T,X>> ix_0 = ix_b;
+    std::vector<std::pair<T,X>> ix_m = ix_b;
+    M_V.move(&ix_b[0],ix_b.size());
+    M.move(&ix_m[0],ix_m.size());
+    for (uint64_t j=0; j<ix_0.size(); j++) {
+        check(ix_b[j] == ix_1[j] && ix_m[j] == ix_1[j],name+": batched move");
+        check((uint64_t) ix_b[j].first == inst.f(ix_0[j].first),name+": batched move f_I");
+    }
+
+    // a batch shorter than the pipeline
+    std::vector<std::pair<T,X>> ix_s(ix_0.begin(),ix_0.begin()+3);
+    M_V.move(&ix_s[0],ix_s.size());
+    check(std::equal(ix_s.begin(),ix_s.end(),ix_1.begin()),name+": short batched move");
+}
+
+/**
+ * @brief checks views of M, of M with its lookup table and the exponential scan, and of the serialized M
+ *        against the queries of M
+ */
+template <typename T, typename X>
+void test_view(const test_instance<T> &inst, const mds<T,X> &M, std::string name, std::mt19937_64 &g) {
+    name += " view";
+    mds<T,X> M_L = M;
+    M_L.build_lut();
+    M_L.set_exp_scan(2);
+
+    std::stringstream ss;
+    uint64_t size = M.serialize(ss);
+    std::string buf = ss.str();
+
+    std::vector<std::pair<mds_view<T,X>,std::string>> views{
+        {mds_view<T,X>(M),name},
+        {mds_view<T,X>(M_L),name+" lut"},
+        {mds_view<T,X>(buf.data()),name+" serialized"}
+    };
+    views.back().first.set_exp_scan(2);
+
+    for (auto &[M_V,name_v] : views) {
+        check(M_V.intervals() == M.intervals() && M_V.max_value() == M.max_value(),name_v+": size");
+        check(M_V.size_in_bytes() == size && buf.size() == size,name_v+": size_in_bytes");
+        test_move_view(inst,M,M_V,name_v,g);
+    }
+}
+
+/**
+ * @brief builds the move datastructure of f_I with a maximum interval length and checks, that no interval is
+ *        longer than l_max, that the intervals are still balanced and that f_I is unchanged
+ */
+template <typename T>
+void test_l_max(const test_instance<T> &inst, T a, int p, int v, std::string name, std::mt19937_64 &g) {
+    for (T l_max : {(T) (1+g()%8),(T) std::max<uint64_t>(1,inst.n/inst.I.size())}) {
+        std::string name_l = name + " l_max=" + std::to_string(l_max);
+        std::vector<std::pair<T,T>> *I = new std::vector<std::pair<T,T>>(inst.I);
+        mds<T> M(I,(T) inst.n,a,p,v,false,NULL,l_max);
+        if (v == 1) delete I;
+
+        T l = 0;
+        for (T x=0; x<M.intervals(); x++) {
+            l = std::max<T>(l,M.pair(x+1).first-M.pair(x).first);
+        }
+        check(l <= l_max,name_l+": interval length");
+
+        uint64_t i = 0;
+        while (i < inst.n) {
+            std::pair<T,T> ix{(T) i,M.locate_interval((T) i)};
+            M.move(ix);
+            if ((uint64_t) ix.first != inst.f(i)) break;
+            i++;
+        }
+        check(i == inst.n,name_l+": f_I");
+        test_mds(inst,M,a,name_l,g);
+    }
+}
+
+/**
+ * @brief builds the inverse of M with each build method, without and with splitting long intervals, and
+ *        checks, that the move queries of the inverse followed by those of M are the identity on [0..n-1]
+ */
+template <typename T, typename X>
+void test_inverse(const test_instance<T> &inst, const mds<T,X> &M, T a, std::string name) {
+    int p_max = std::min(4,omp_get_max_threads());
+
+    for (int v : {1,2,3,4}) {
+        // the build methods 2/3/4 sort by the permutation computed by inverse, build method 1 does not
+        if (v == 4 && p_max < 2) continue;
+        int p = v <= 2 ? 1 : p_max;
+
+        for (T l_max : {(T) 0,(T) std::max<uint64_t>(1,inst.n/inst.I.size())}) {
+            std::string name_v = name + " inverse v=" + std::to_string(v) + " l_max=" + std::to_string(l_max);
+            mds<T,X> M_inv = M.inverse(a,p,v,false,NULL,l_max);
+            check(M_inv.max_value() == M.max_value(),name_v+": size");
+
+            for (uint64_t i=0; i<inst.n; i++) {
+                std::pair<T,X> ix{(T) i,M_inv.locate_interval((T) i)};
+                M_inv.move(ix);
+                std::pair<T,X> ix_f{ix.first,M.locate_interval(ix.first)};
+                M.move(ix_f);
+                if (ix_f.first != (T) i) {
+                    check(false,name_v+": round trip");
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief checks move_bulk on unsorted pairs with duplicates, ordered and unordered, with the automatic and
+ *        with fixed bucket widths, against single move queries
+ */
+template <typename T, typename X>
+void test_move_bulk(const test_instance<T> &inst, const mds<T,X> &M, std::string name, std::mt19937_64 &g) {
+    name += " move_bulk";
+    std::vector<std::pair<T,X>> ix;
+    for (uint64_t i : random_positions(inst.n,3000,g)) {
+        ix.emplace_back((T) i,M.locate_interval((T) i));
+        // duplicates
+        if (g()%4 == 0) ix.emplace_back(ix.back());
+    }
+    std::shuffle(ix.begin(),ix.end(),g);
+
+    std::vector<std::pair<T,X>> ix_1 = ix;
+    for (std::pair<T,X> &ix_ : ix_1) {
+        M.move(ix_);
+    }
+    std::vector<std::pair<T,X>> ix_1s = ix_1;
+    std::sort(ix_1s.begin(),ix_1s.end());
+
+    for (int s : {-1,0,3,20}) {
+        std::string name_s = name + " s=" + std::to_string(s);
+        std::vector<std::pair<T,X>> ix_o = ix;
+        M.move_bulk(ix_o,true,s);
+        check(ix_o == ix_1,name_s+": ordered");
+
+        std::vector<std::pair<T,X>> ix_u = ix;
+        M.move_bulk(ix_u,false,s);
+        std::sort(ix_u.begin(),ix_u.end());
+        check(ix_u == ix_1s,name_s+": unordered");
+    }
+
+    std::vector<std::pair<T,X>> ix_0;
+    M.move_bulk(ix_0);
+    check(ix_0.empty(),name+": empty");
+}
+
+/**
+ * @brief checks the executor on M and on M with the exponential scan against repeated move queries and
+ *        f_I, with few lanes and small chunks, so that lanes are refilled and chunks are split
+ */
+template <typename T, typename X>
+void test_exec(const test_instance<T> &inst, const mds<T,X> &M, std::string name, std::mt19937_64 &g) {
+    name += " exec";
+    mds<T,X> M_T = M;
+    M_T.set_exp_scan(2);
+
+    for (const mds<T,X> *M_ : {&M,(const mds<T,X>*) &M_T}) {
+        mds_exec<T,X> E(M_,std::min(4,omp_get_max_threads()),3,100);
+        std::vector<std::pair<T,X>> ix;
+        std::vector<uint64_t> steps;
+        uint64_t moves = 0;
+        for (uint64_t i : random_positions(inst.n,2000,g)) {
+            ix.emplace_back((T) i,M.locate_interval((T) i));
+            steps.emplace_back(g()%8);
+            moves += steps.back();
+        }
+        std::vector<std::pair<T,X>> ix_e = ix;
+        std::vector<std::pair<T,X>> ix_u = ix;
+
+        E.run(ix_e,steps);
+        check(E.moves() == moves,name+": moves");
+        for (uint64_t j=0; j<ix.size(); j++) {
+            uint64_t i = ix[j].first;
+            for (uint64_t s=0; s<steps[j]; s++) {
+                M.move(ix[j]);
+                i = inst.f(i);
+            }
+            check(ix_e[j] == ix[j] && (uint64_t) ix_e[j].first == i,name+": run");
+        }
+
+        std::vector<std::pair<T,X>> ix_w = ix_u;
+        E.run(ix_u,5);
+        check(E.moves() == 5*ix_u.size(),name+": moves (uniform)");
+        for (uint64_t j=0; j<ix_u.size(); j++) {
+            check(ix_u[j] == M.walk(ix_w[j],5),name+": run (uniform)");
+        }
+
+        std::vector<std::pair<T,X>> ix_0;
+        E.run(ix_0,5);
+        check(E.moves() == 0 && E.runtime() == 0,name+": empty run");
+    }
+}
+
+/**
+ * @brief checks single walkers and the strided walkers of the scheduler on M and on M with the exponential
+ *        scan against repeated move queries, walk and f_I
+ */
+template <typename T, typename X>
+void test_sched(const test_instance<T> &inst, const mds<T,X> &M, std::string name, std::mt19937_64 &g) {
+    name += " sched";
+    mds<T,X> M_T = M;
+    M_T.set_exp_scan(2);
+
+    for (const mds<T,X> *M_ : {&M,(const mds<T,X>*) &M_T}) {
+        mds_sched<T,X> S(M_);
+        std::vector<std::pair<T,X>> ix;
+        std::vector<uint64_t> steps;
+        for (uint64_t i : random_positions(inst.n,500,g)) {
+            ix.emplace_back((T) i,M.locate_interval((T) i));
+            steps.emplace_back(g()%8);
+        }
+        std::vector<std::pair<T,X>> ix_s = ix;
+        std::vector<std::pair<T,X>> ix_w = ix;
+
+        for (uint64_t j=0; j<ix.size(); j++) {
+            S.add(S.walk(ix_s[j],steps[j]));
+        }
+        S.run();
+        for (uint64_t j=0; j<ix.size(); j++) {
+            uint64_t i = ix[j].first;
+            for (uint64_t s=0; s<steps[j]; s++) {
+                M.move(ix[j]);
+                i = inst.f(i);
+            }
+            check(ix_s[j] == ix[j] && (uint64_t) ix_s[j].first == i,name+": walker");
+        }
+
+        std::vector<std::pair<T,X>> ix_v = ix_w;
+        S.walk(ix_v,5,7);
+        for (uint64_t j=0; j<ix_w.size(); j++) {
+            check(ix_v[j] == M.walk(ix_w[j],5),name+": walk");
+        }
+    }
+}
+
+/**
+ * @brief writes M to a file, maps it and checks the mapped view against M; then checks, that a file with a
+ *        corrupt k, a truncated file and a file in the format without a header are rejected
+ */
+template <typename T, typename X>
+void test_mmap(const test_instance<T> &inst, const mds<T,X> &M, std::string name, std::mt19937_64 &g) {
+    name += " mmap";
+    std::string path = (std::filesystem::temp_directory_path() / "mds_unit_test.mds").string();
+    std::string buf;
+    {
+        std::ofstream out(path,std::ios::binary);
+        M.serialize(out);
+    }
+    {
+        std::ifstream in(path,std::ios::binary);
+        buf.assign(std::istreambuf_iterator<char>(in),std::istreambuf_iterator<char>());
+    }
+
+    {
+        mds_mmap<T,X> M_M(path,true);
+        check(M_M.good() && M_M.intervals() == M.intervals() && M_M.size_in_bytes() == buf.size(),name+": size");
+        if (M_M.good()) test_move_view(inst,M,M_M,name,g);
+
+        // the mapping moves with the view
+        mds_mmap<T,X> M_M2(std::move(M_M));
+        check(!M_M.good() && M_M2.good(),name+": move");
+    }
+
+    // the largest k, whose size_in_bytes() overflows, and a k larger than the file
+    for (uint64_t k : {(uint64_t) std::numeric_limits<X>::max(),(uint64_t) M.intervals()+1}) {
+        std::string buf_c = buf;
+        std::copy((const char*) &k,(const char*) &k+8,&buf_c[24]);
+        std::ofstream(path,std::ios::binary).write(buf_c.data(),buf_c.size());
+        check(!mds_mmap<T,X>(path).good(),name+": corrupt k");
+    }
+
+    std::ofstream(path,std::ios::binary).write(buf.data(),buf.size()-1);
+    check(!mds_mmap<T,X>(path).good(),name+": truncated file");
+    check(!mds_mmap<T,X>(path+".missing").good(),name+": missing file");
+
+    // n, k, D_pair[0..k] and D_index[0..k-1] without a header
+    {
+        std::ofstream out(path,std::ios::binary);
+        T n = M.max_value();
+        X k = M.intervals();
+        out.write((const char*) &n,sizeof(T));
+        out.write((const char*) &k,sizeof(X));
+        for (X x=0; x<=k; x++) {
+            out.write((const char*) &M.pair(x),2*sizeof(T));
+        }
+        for (X x=0; x<k; x++) {
+            X x_i = M.index(x);
+            out.write((const char*) &x_i,sizeof(X));
+        }
+    }
+    check(!mds_mmap<T,X>(path).good(),name+": format without a header");
+    std::ifstream in(path,std::ios::binary);
+    mds<T,X> M_old(in);
+    check(in.fail() && M_old.intervals() == 0,name+": format without a header (stream)");
+
+    std::filesystem::remove(path);
+}
+
+/**
+ * @brief checks an unsigned X, whose highest bit is needed to store k, so that the build methods must not use
+ *        the fast_bit, with mds, its views, its mapped file and its serialization round trip
+ */
+template <typename T, typename X>
+void test_high_bit(std::mt19937_64 &g) {
+    uint64_t k_min = (uint64_t) 1 << (8*sizeof(X)-1);
+    test_instance<T> inst(4*k_min,k_min+k_min/8,g);
+
+    for (int v : {1,3}) {
+        int p = v == 3 ? std::min(4,omp_get_max_threads()) : 1;
+        std::string name = "high bit of X, v=" + std::to_string(v);
+        mds<T,X> M = inst.template build<X>(4,p,v);
+        check(M.intervals() >= k_min,name+": k");
+        test_mds(inst,M,(T) 4,name,g);
+        test_view(inst,M,name,g);
+        test_mmap(inst,M,name,g);
+    }
+}
+
+/**
+ * @brief checks mds<uint32_t> with n close to 2^32, so that most positions are >= 2^31 and do not fit into
+ *        int32_t, against f_I
+ */
+void test_uint32(std::mt19937_64 &g) {
+    uint64_t n = std::numeric_limits<uint32_t>::max()-5;
+
+    for (int it=0; it<4; it++) {
+        uint64_t k = 50+g()%3000;
+        test_instance<uint32_t> inst(n,k,g);
+
+        for (uint32_t a : {2,4}) {
+            for (int v : {1,3}) {
+                int p = v == 3 ? std::min(4,omp_get_max_threads()) : 1;
+                std::string name = "uint32_t n=" + std::to_string(n) + " k=" + std::to_string(k) + " a=" + std::to_string(a) + " v=" + std::to_string(v);
+                mds<uint32_t> M = inst.build(a,p,v);
+                test_mds(inst,M,a,name,g);
+                test_view(inst,M,name,g);
+            }
+        }
+    }
+}
+
+/**
+ * @brief builds instances with 40-bit positions and 32-bit interval indices, with n > 2^32, so that the
+ *        upper byte of uint40_t is used, and checks mds, its views, move_bulk and the executor
+ */
+void test_uint40(std::mt19937_64 &g) {
+    for (int it=0; it<2; it++) {
+        uint64_t n = ((uint64_t) 1 << 32)+1+g()%((uint64_t) 1 << 34);
+        uint64_t k = 50+g()%3000;
+        test_instance<uint40_t> inst(n,k,g);
+
+        for (int v : {1,3}) {
+            int p = v == 3 ? std::min(4,omp_get_max_threads()) : 1;
+            std::string name = "uint40_t n=" + std::to_string(n) + " k=" + std::to_string(k) + " v=" + std::to_string(v);
+            mds<uint40_t,uint32_t> M = inst.build<uint32_t>(2,p,v);
+            test_mds(inst,M,(uint40_t) 2,name,g);
+            test_view(inst,M,name,g);
+            test_move_bulk(inst,M,name,g);
+            test_exec(inst,M,name,g);
+        }
+    }
+}
+
+/**
+ * @brief builds random instances with every balancing parameter in {2,4} and build method 1/2/3 and
+ *        checks mds and the variants built from it
+ */
+template <typename T>
+void test_all(std::mt19937_64 &g) {
+    for (int it=0; it<8; it++) {
+        uint64_t n = 1000+g()%50000;
+        uint64_t k = 2+g()%std::min<uint64_t>(n/2-1,2000);
+        test_instance<T> inst(n,k,g);
+
+        for (T a : {2,4}) {
+            for (int v : {1,2,3}) {
+                int p = v == 3 ? std::min(4,omp_get_max_threads()) : 1;
+                std::string name = "n=" + std::to_string(n) + " k=" + std::to_string(k) + " a=" + std::to_string(a) + " v=" + std::to_string(v);
+
+                mds<T> M = inst.build(a,p,v);
+                test_mds(inst,M,a,name,g);
+                test_move_range(inst,M,name,g);
+                test_move_bulk(inst,M,name,g);
+                test_fused(inst,M,name,g);
+                test_simd(inst,M,name,g);
+                test_view(inst,M,name,g);
+                test_exec(inst,M,name,g);
+                test_sched(inst,M,name,g);
+                if (v == 3) test_mmap(inst,M,name,g);
+                if (v == 3) test_inverse(inst,M,a,name);
+                test_l_max(inst,a,p,v,name,g);
+                test_compressed<mds_blocked<T,32>>(inst,M,name+" blocked B=32",g);
+                test_compressed<mds_blocked<T,8>>(inst,M,name+" blocked B=8",g);
+                test_compressed<mds_packed<T>>(inst,M,name+" packed",g);
+                test_compressed<mds_offset<T>>(inst,M,name+" offset",g);
+                test_compressed<mds_ef<T>>(inst,M,name+" ef",g);
+                if constexpr (sizeof(T) <= 4) test_cl(inst,M,name,g);
+                if (a == 2) {
+                    test_fixed<T,2>(inst,p,v,name,g);
+                } else {
+                    test_fixed<T,4>(inst,p,v,name,g);
+                }
+
+                if constexpr (sizeof(T) == 8) {
+                    // 32-bit interval indices with 64-bit positions
+                    mds<T,uint32_t> M_X = inst.template build<uint32_t>(a,p,v);
+                    test_mds(inst,M_X,a,name+" X=uint32_t",g);
+                    test_view(inst,M_X,name+" X=uint32_t",g);
+                    test_move_bulk(inst,M_X,name+" X=uint32_t",g);
+                    test_exec(inst,M_X,name+" X=uint32_t",g);
+                    test_sched(inst,M_X,name+" X=uint32_t",g);
+                    if (v == 3) test_mmap(inst,M_X,name+" X=uint32_t",g);
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    std::mt19937_64 g(42);
+
+    test_all<int32_t>(g);
+    test_all<int64_t>(g);
+    test_high_bit<int32_t,uint16_t>(g);
+    test_uint32(g);
+    test_uint40(g);
+    test_ef_vector<int32_t>(g);
+
+    std::cout << (failures == 0 ? "all checks passed" : std::to_string(failures) + " checks failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file